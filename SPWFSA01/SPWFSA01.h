@@ -57,10 +57,18 @@ public:
      */
     nsapi_size_or_error_t scan(WiFiAccessPoint *res, unsigned limit);
 
+    /** Scan for available networks, delivering each result as soon as it has been received
+     *
+     * @param  cb     Called for each discovered AP matching @a filter, returns false to stop delivering further APs
+     * @param  filter Filter to apply on discovered APs, or NULL to deliver all of them
+     * @return        Number of APs delivered to @a cb, negative on error see @a nsapi_error
+     */
+    nsapi_size_or_error_t scanStream(spwfsa_scan_cb_t cb, const spwfsa_scan_filter_t *filter);
+
 private:
     bool _recv_ap(nsapi_wifi_ap_t *ap);
 
-    virtual int _read_in(char*, int, uint32_t);
+    virtual int _read_in(struct chunk*, unsigned int, int, uint32_t);
 };
 
 #endif // SPWFSA01_H
@@ -25,7 +25,7 @@
 
 #define SPWFXX_OOB_ERROR            "ERROR:"                                            // "AT-S.ERROR:"
 
-#define SPWFXX_RECV_OK              "OK\n"                                              // "AT-S.OK\n"
+#define SPWFXX_LINE_OK              "OK"                                                // "AT-S.OK"
 #define SPWFXX_RECV_WIFI_UP         "+WIND:24:WiFi Up:%u.%u.%u.%u\n"                    // "+WIND:24:WiFi Up:%*u:%u.%u.%u.%u\n"
 #define SPWFXX_RECV_IP_ADDR         "#  ip_ipaddr = %u.%u.%u.%u\n"                      // "AT-S.Var:ip_ipaddr=%u.%u.%u.%u\n"
 #define SPWFXX_RECV_GATEWAY         "#  ip_gw = %u.%u.%u.%u\n"                          // "AT-S.Var:ip_gw=%u.%u.%u.%u\n"
@@ -41,6 +41,7 @@
 #define SPWFXX_SEND_DSPLY_CFGV      "AT&V"                                              // "AT+S.GCFG"
 #define SPWFXX_SEND_GET_CONS_STATE  "AT+S.GCFG=console1_enabled"                        // "AT+S.GCFG=console_enabled"
 #define SPWFXX_SEND_GET_CONS_SPEED  "AT+S.GCFG=console1_speed"                          // "AT+S.GCFG=console_speed"
+#define SPWFXX_SEND_SET_CONS_SPEED  "AT+S.SCFG=console1_speed,"                         // "AT+S.SCFG=console_speed,"
 #define SPWFXX_SEND_GET_HWFC_STATE  "AT+S.GCFG=console1_hwfc"                           // "AT+S.GCFG=console_hwfc"
 #define SPWFXX_SEND_GET_CONS_DELIM  "AT+S.GCFG=console1_delimiter"                      // "AT+S.GCFG=console_delimiter"
 #define SPWFXX_SEND_GET_CONS_ERRS   "AT+S.GCFG=console1_errs"                           // "AT+S.GCFG=console_errs"
@@ -33,7 +33,7 @@ bool SPWFSA04::open(const char *type, int* spwf_id, const char* addr, int port)
     int value;
     int trials;
 
-    if(!_parser.send("AT+S.SOCKON=%s,%d,NULL,%s", addr, port, type))
+    if(!_send_cmd("AT+S.SOCKON=%s,%d,NULL,%s", addr, port, type))
     {
         debug_if(_dbg_on, "\r\nSPWF> `SPWFSA04::open`: error opening socket (%d)\r\n", __LINE__);
         return false;
@@ -101,19 +101,19 @@ bool SPWFSA04::open(const char *type, int* spwf_id, const char* addr, int port)
     return false;
 }
 
-int SPWFSA04::_read_in(char* buffer, int spwf_id, uint32_t amount) {
+/* Note: reads in overall `amount` bytes into the `count` `chunks` (with one single `SOCKR`) */
+int SPWFSA04::_read_in(struct chunk *chunks, unsigned int count, int spwf_id, uint32_t amount) {
     int ret = -1;
     int received, cumulative;
 
-    MBED_ASSERT(buffer != NULL);
+    MBED_ASSERT((chunks != NULL) && (count > 0));
 
-    /* block asynchronous indications */
-    if(!_winds_off()) {
-        return -1;
-    }
+    /* asynchronous indications MUST have been blocked by the caller (see `_read_in_pkt()`) */
+    MBED_ASSERT(_winds_off_cnt > 0);
 
     /* read in data */
-    if(_parser.send("AT+S.SOCKR=%d,%d", spwf_id, (unsigned int)amount)) {
+    _rx_at_cmd_cnt++;
+    if(_send_cmd("AT+S.SOCKR=%d,%d", spwf_id, (unsigned int)amount)) {
         if(!(_parser.recv("AT-S.Reading:%d:%d\n", &received, &cumulative) &&
                 _recv_delim_lf())) {
             debug_if(_dbg_on, "\r\nSPWF> failed to receive AT-S.Reading (%s, %d)\r\n", __func__, __LINE__);
@@ -122,7 +122,7 @@ int SPWFSA04::_read_in(char* buffer, int spwf_id, uint32_t amount) {
             /* set high timeout */
             _parser.set_timeout(SPWF_READ_BIN_TIMEOUT);
             /* read in binary data */
-            int read = _parser.read(buffer, amount);
+            int read = _read_in_chunks(chunks, count);
             /* reset timeout value */
             _parser.set_timeout(_timeout);
             if(read > 0) {
@@ -131,7 +131,7 @@ int SPWFSA04::_read_in(char* buffer, int spwf_id, uint32_t amount) {
 
                     /* remove from pending sizes
                      * (MUST be done before next async indications handling (e.g. `_winds_on()`)) */
-                    _remove_pending_pkt_size(spwf_id, amount);
+                    _remove_pending_pkt_sizes(spwf_id, amount);
                 } else {
                     debug_if(_dbg_on, "\r\nSPWF> failed to receive OK (%s, %d)\r\n", __func__, __LINE__);
                     empty_rx_buffer();
@@ -145,20 +145,16 @@ int SPWFSA04::_read_in(char* buffer, int spwf_id, uint32_t amount) {
         debug_if(_dbg_on, "%s(%d): failed to send SOCKR\r\n", __func__, __LINE__);
     }
 
-    debug_if(_dbg_on, "\r\nSPWF> %s():\t%d:%d\r\n", __func__, spwf_id, amount);
-
-    /* unblock asynchronous indications */
-    _winds_on();
+    SPWFXX_TRACE(SPWFSA_TRACE_READ_IN, spwf_id, amount, count,
+                 "\r\nSPWF> %s():\t%d:%d\r\n", __func__, spwf_id, amount);
 
     return ret;
 }
 
-/* betzw - TODO: improve performance! */
 bool SPWFSA04::_recv_ap(nsapi_wifi_ap_t *ap)
 {
     bool ret;
     int curr;
-    unsigned int channel;
     int trials;
 
     ap->security = NSAPI_SECURITY_UNKNOWN;
@@ -182,109 +178,59 @@ bool SPWFSA04::_recv_ap(nsapi_wifi_ap_t *ap)
         }
     }
 
-    /* read in next line */
-    ret = _parser.recv("%255[^\n]\n", _msg_buffer) && _recv_delim_lf();
-
-    /* parse line - first phase */
-    if(ret) {
-        int val = sscanf(_msg_buffer,
-                         " %*s %hhx:%hhx:%hhx:%hhx:%hhx:%hhx CHAN: %u RSSI: %hhd SSID: \'%*255[^\']\'",
-                         &ap->bssid[0], &ap->bssid[1], &ap->bssid[2], &ap->bssid[3], &ap->bssid[4], &ap->bssid[5],
-                         &channel, &ap->rssi);
-        if(val < 8) {
-            ret = false;
-        }
+    /* parse line (directly from UART) */
+    ret = _recv_ap_line(ap);
+    if(!ret) {
+        debug("\r\nSPWF> WARNING: might happen in case of RX buffer overflow! (%s, %d)\r\n", __func__, __LINE__);
+        empty_rx_buffer();
     }
 
-    /* parse line - second phase */
-    if(ret) { // ret == true
-        char value;
-        char *rest, *first, *last;
-
-        /* decide about position of `CAPS:` */
-        first = strchr(_msg_buffer, '\'');
-        if(first == NULL) {
-            debug("\r\nSPWF> WARNING: might happen in case of RX buffer overflow! (%s, %d)\r\n", __func__, __LINE__);
-            empty_rx_buffer();
-            return false;
-        }
-        last = strrchr(_msg_buffer, '\'');
-        if((last == NULL) || (last < (first+1))) {
-            debug("\r\nSPWF> WARNING: might happen in case of RX buffer overflow! (%s, %d)\r\n", __func__, __LINE__);
-            empty_rx_buffer();
-            return false;
-        }
-        rest = strstr(last, "CAPS:");
-        if(rest == NULL) {
-            debug("\r\nSPWF> WARNING: might happen in case of RX buffer overflow! (%s, %d)\r\n", __func__, __LINE__);
-            empty_rx_buffer();
-            return false;
-        }
+    return ret;
+}
 
-        /* substitute '\'' with '\0' */
-        *last = '\0';
+nsapi_size_or_error_t SPWFSA04::scan(WiFiAccessPoint *res, unsigned limit)
+{
+    unsigned int cnt = 0, found;
+    nsapi_wifi_ap_t ap;
 
-        /* copy values */
-        memcpy(&ap->ssid, first+1, sizeof(ap->ssid)-1);
-        ap->ssid[sizeof(ap->ssid)-1] = '\0';
-        ap->channel = channel;
+    if (!_send_cmd("AT+S.SCAN=s,")) {
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
 
-        /* skip `CAPS: 0421 ` */
-        if(strlen(rest) < 11) {
-            debug("\r\nSPWF> WARNING: might happen in case of RX buffer overflow! (%s, %d)\r\n", __func__, __LINE__);
-            empty_rx_buffer();
-            return false;
-        }
-        rest += 11;
+    if(!(_parser.recv("AT-S.Parsing Networks:%u\n", &found) && _recv_delim_lf())) {
+        debug_if(_dbg_on, "SPWF> error start network scanning\r\n");
+        empty_rx_buffer();
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
 
-        /* get next character */
-        value = *rest++;
-        if(value != 'W') { // no security
-            ap->security = NSAPI_SECURITY_NONE;
-            return true;
-        }
+    debug_if(_dbg_on, "AT^ AT-S.Parsing Networks:%u\r\n", found);
 
-        /* determine security */
-        {
-            char buffer[10];
-
-            if(!(sscanf(rest, "%s%*[\x20]", (char*)&buffer) > 0)) { // '\0x20' == <space>
-                return true;
-            } else if(strncmp("EP", buffer, 10) == 0) {
-                ap->security = NSAPI_SECURITY_WEP;
-                return true;
-            } else if(strncmp("PA2", buffer, 10) == 0) {
-                ap->security = NSAPI_SECURITY_WPA2;
-                return true;
-            } else if(strncmp("PA", buffer, 10) != 0) {
-                return true;
+    if(found > 0) {
+        while (_recv_ap(&ap)) {
+            if (cnt < limit) {
+                res[cnt] = WiFiAccessPoint(ap);
             }
 
-            /* got a "WPA", check for "WPA2" */
-            rest += strlen(buffer);
-            value = *rest++;
-            if(value == '\0') { // no further protocol
-                ap->security = NSAPI_SECURITY_WPA;
-                return true;
-            } else { // assume "WPA2"
-                ap->security = NSAPI_SECURITY_WPA_WPA2;
-                return true;
+            if (!((limit != 0) && ((cnt + 1) > limit))) {
+                cnt++;
             }
         }
-    } else { // ret == false
-        debug("\r\nSPWF> WARNING: might happen in case of RX buffer overflow! (%s, %d)\r\n", __func__, __LINE__);
-        empty_rx_buffer();
+    } else {
+        if(!_recv_ok()) {
+            empty_rx_buffer();
+        }
     }
 
-    return ret;
+    return cnt;
 }
 
-nsapi_size_or_error_t SPWFSA04::scan(WiFiAccessPoint *res, unsigned limit)
+nsapi_size_or_error_t SPWFSA04::scanStream(spwfsa_scan_cb_t cb, const spwfsa_scan_filter_t *filter)
 {
     unsigned int cnt = 0, found;
+    bool deliver = true;
     nsapi_wifi_ap_t ap;
 
-    if (!_parser.send("AT+S.SCAN=s,")) {
+    if (!_send_cmd("AT+S.SCAN=s,")) {
         return NSAPI_ERROR_DEVICE_ERROR;
     }
 
@@ -297,13 +243,11 @@ nsapi_size_or_error_t SPWFSA04::scan(WiFiAccessPoint *res, unsigned limit)
     debug_if(_dbg_on, "AT^ AT-S.Parsing Networks:%u\r\n", found);
 
     if(found > 0) {
+        /* Note: after early termination the remaining results still need to be consumed */
         while (_recv_ap(&ap)) {
-            if (cnt < limit) {
-                res[cnt] = WiFiAccessPoint(ap);
-            }
-
-            if (!((limit != 0) && ((cnt + 1) > limit))) {
+            if (deliver && _scan_filter_match(&ap, filter)) {
                 cnt++;
+                deliver = cb(WiFiAccessPoint(ap));
             }
         }
     } else {
@@ -32,7 +32,7 @@
 
 #define SPWFXX_OOB_ERROR            "AT-S.ERROR:"                                           // "ERROR:"
 
-#define SPWFXX_RECV_OK              "AT-S.OK\n"                                             // "OK\n"
+#define SPWFXX_LINE_OK              "AT-S.OK"                                               // "OK"
 #define SPWFXX_RECV_WIFI_UP         "+WIND:24:WiFi Up:%*u:%u.%u.%u.%u\n"                    // "+WIND:24:WiFi Up:%u.%u.%u.%u\n"
 #define SPWFXX_RECV_IP_ADDR         "AT-S.Var:ip_ipaddr=%u.%u.%u.%u\n"                      // "#  ip_ipaddr = %u.%u.%u.%u\n"
 #define SPWFXX_RECV_GATEWAY         "AT-S.Var:ip_gw=%u.%u.%u.%u\n"                          // "#  ip_gw = %u.%u.%u.%u\n"
@@ -48,6 +48,7 @@
 #define SPWFXX_SEND_DSPLY_CFGV      "AT+S.GCFG"                                             // "AT&V"
 #define SPWFXX_SEND_GET_CONS_STATE  "AT+S.GCFG=console_enabled"                             // "AT+S.GCFG=console1_enabled"
 #define SPWFXX_SEND_GET_CONS_SPEED  "AT+S.GCFG=console_speed"                               // "AT+S.GCFG=console1_speed"
+#define SPWFXX_SEND_SET_CONS_SPEED  "AT+S.SCFG=console_speed,"                              // "AT+S.SCFG=console1_speed,"
 #define SPWFXX_SEND_GET_HWFC_STATE  "AT+S.GCFG=console_hwfc"                                // "AT+S.GCFG=console1_hwfc"
 #define SPWFXX_SEND_GET_CONS_DELIM  "AT+S.GCFG=console_delimiter"                           // "AT+S.GCFG=console1_delimiter"
 #define SPWFXX_SEND_GET_CONS_ERRS   "AT+S.GCFG=console_errs"                                // "AT+S.GCFG=console1_errs"
@@ -19,6 +19,14 @@
 #include "SpwfSAInterface.h" /* must be included first */
 #include "SPWFSAxx.h"
 
+#if MBED_CONF_RTOS_PRESENT
+#define PKT_SYNC_HANDLER ScopedMutexLock pkt_sync_handler(_pkt_mutex)  // packet queues & pool
+#define CACHE_SYNC_HANDLER ScopedMutexLock cache_sync_handler(_cache_mutex)  // network parameter cache
+#else
+#define PKT_SYNC_HANDLER
+#define CACHE_SYNC_HANDLER
+#endif
+
 static const char out_delim[] = {SPWFSAxx::_cr_, '\0'};
 
 SPWFSAxx::SPWFSAxx(PinName tx, PinName rx,
@@ -31,29 +39,51 @@ SPWFSAxx::SPWFSAxx(PinName tx, PinName rx,
   _timeout(SPWF_INIT_TIMEOUT), _dbg_on(debug),
   _pending_sockets_bitmap(0),
   _network_lost_flag(false),
+  _winds_off_cnt(0), _winds_held(false), _winds_hold_stamp(0),
+  _baud_rate(SPWFXX_DEFAULT_BAUD_RATE),
+  _rx_at_cmd_cnt(0), _rx_bytes_cnt(0),
+  _closing_sockets_bitmap(0),
   _associated_interface(ifce),
   _call_event_callback_blocked(0),
   _callback_func(),
-  _packets(0), _packets_end(&_packets)
+  _irq_events(0), _irq_events_seen(0),
+  _engine(SPWFXX_LINE_OK, SPWFXX_OOB_ERROR)
 {
     memset(_pending_pkt_sizes, 0, sizeof(_pending_pkt_sizes));
 
+    _rssi = 0;
+    _cfg_valid = false;
+    _radio_off = false;
+    memset(&_connect_timing, 0, sizeof(_connect_timing));
+    _startup_ms = 0;
+    _packet_pool_oom = false;
+    _assoc_state = SPWFSA_ASSOC_IDLE;
+    _assoc_deauths = 0;
+    _cache_valid_bitmap = 0;
+    memset(&_close_stats, 0, sizeof(_close_stats));
+
+#if SPWFSA_TRACE_SIZE > 0
+    _trace_wr = 0;
+    _trace_rd = 0;
+#endif // SPWFSA_TRACE_SIZE > 0
+
+#if SPWFSA_AT_LATENCY_STATS
+    resetAtLatencyStats();
+#endif // SPWFSA_AT_LATENCY_STATS
+
+    for(int spwf_id = 0; spwf_id < SPWFSA_SOCKET_COUNT; spwf_id++) {
+        _packets[spwf_id] = 0;
+        _packets_end[spwf_id] = &_packets[spwf_id];
+    }
+
     _serial.sigio(Callback<void()>(this, &SPWFSAxx::_event_handler));
     _parser.debug_on(debug);
     _parser.set_timeout(_timeout);
 
-    /* unlikely OOBs */
-    _parser.oob("+WIND:5:WiFi Hardware Failure", callback(this, &SPWFSAxx::_wifi_hwfault_handler));
-    _parser.oob("+WIND:33:WiFi Network Lost", callback(this, &SPWFSAxx::_network_lost_handler_th));
-#if MBED_CONF_IDW0XX1_EXPANSION_BOARD == IDW04A1
-    _parser.oob("+WIND:24:WiFi Up::", callback(this, &SPWFSAxx::_skip_oob));
-#endif
-    _parser.oob("+WIND:8:Hard Fault", callback(this, &SPWFSAxx::_hard_fault_handler));
-
-    /* most likely OOBs */
-    _parser.oob(SPWFXX_OOB_ERROR, callback(this, &SPWFSAxx::_error_handler));
-    _parser.oob("+WIND:58:Socket Closed", callback(this, &SPWFSAxx::_server_gone_handler));
-    _parser.oob("+WIND:55:Pending Data", callback(this, &SPWFSAxx::_packet_handler_th));
+    /* OOBs (only hit while `_parser.recv()`-ing command specific replies,
+     * the rest of the line gets tokenized & dispatched by the protocol engine) */
+    _parser.oob(SPWFXX_OOB_ERROR, callback(this, &SPWFSAxx::_error_oob_handler));
+    _parser.oob(SPWF_PROTOCOL_WIND_PREFIX, callback(this, &SPWFSAxx::_wind_oob_handler));
 }
 
 bool SPWFSAxx::startup(int mode)
@@ -61,49 +91,69 @@ bool SPWFSAxx::startup(int mode)
     BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
                                  Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
 
+    Timer startup_timer;
+    startup_timer.start();
+
+    if(!_startup(mode, true)) return false;
+
+    _startup_ms = startup_timer.read_ms();
+    return true;
+}
+
+/* reset & configure module (with `upgrade_speed` trying to switch to `SPWFXX_BAUD_RATE`) */
+bool SPWFSAxx::_startup(int mode, bool upgrade_speed)
+{
     /*Reset module*/
-    if(!hw_reset()) {
+    bool reset_ok = hw_reset();
+#if SPWFXX_BAUD_RATE != SPWFXX_DEFAULT_BAUD_RATE
+    if(!reset_ok && (_baud_rate != SPWFXX_BAUD_RATE)) {
+        /* module might still be configured for the upgraded console speed (e.g. by a previous startup) */
+        _set_baud_rate(SPWFXX_BAUD_RATE);
+        reset_ok = hw_reset();
+    }
+#endif // SPWFXX_BAUD_RATE != SPWFXX_DEFAULT_BAUD_RATE
+    if(!reset_ok) {
         debug_if(_dbg_on, "\r\nSPWF> HW reset failed\r\n");
         return false;
     }
 
     /* factory reset */
-    if(!(_parser.send(SPWFXX_SEND_FWCFG) && _recv_ok()))
+    if(!(_send_cmd(SPWFXX_SEND_FWCFG) && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error restore factory default settings\r\n");
         return false;
     }
 
     /*switch off led*/
-    if(!(_parser.send("AT+S.SCFG=blink_led,0") && _recv_ok()))
+    if(!(_send_cmd("AT+S.SCFG=blink_led,0") && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error stop blinking led (%d)\r\n", __LINE__);
         return false;
     }
 
     /*set local echo to 0*/
-    if(!(_parser.send(SPWFXX_SEND_DISABLE_LE) && _recv_ok()))
+    if(!(_send_cmd(SPWFXX_SEND_DISABLE_LE) && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error local echo set\r\n");
         return false;
     }
 
     /*set the operational rates*/
-    if(!(_parser.send("AT+S.SCFG=wifi_opr_rate_mask,0x003FFFCF") && _recv_ok()))
+    if(!(_send_cmd("AT+S.SCFG=wifi_opr_rate_mask,0x003FFFCF") && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error setting ht_mode\r\n");
         return false;
     }
 
     /*enable the 802.11n mode*/
-    if(!(_parser.send("AT+S.SCFG=wifi_ht_mode,1") && _recv_ok()))
+    if(!(_send_cmd("AT+S.SCFG=wifi_ht_mode,1") && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error setting operational rates\r\n");
         return false;
     }
 
     /*set idle mode (0->idle, 1->STA,3->miniAP, 2->IBSS)*/
-    if(!(_parser.send("AT+S.SCFG=wifi_mode,%d", mode) && _recv_ok()))
+    if(!(_send_cmd("AT+S.SCFG=wifi_mode,%d", mode) && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error WiFi mode set idle (%d)\r\n", __LINE__);
         return false;
@@ -112,7 +162,7 @@ bool SPWFSAxx::startup(int mode)
 #if defined(MBED_MAJOR_VERSION)
 #if !DEVICE_SERIAL_FC || (MBED_VERSION < MBED_ENCODE_VERSION(5, 7, 0))
     /*disable HW flow control*/
-    if(!(_parser.send(SPWFXX_SEND_DISABLE_FC) && _recv_ok()))
+    if(!(_send_cmd(SPWFXX_SEND_DISABLE_FC) && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error disabling HW flow control\r\n");
         return false;
@@ -120,7 +170,7 @@ bool SPWFSAxx::startup(int mode)
 #else // DEVICE_SERIAL_FC && (MBED_VERSION >= MBED_ENCODE_VERSION(5, 7, 0))
     if((_rts != NC) && (_cts != NC)) {
         /*enable HW flow control*/
-        if(!(_parser.send(SPWFXX_SEND_ENABLE_FC) && _recv_ok()))
+        if(!(_send_cmd(SPWFXX_SEND_ENABLE_FC) && _recv_ok()))
         {
             debug_if(_dbg_on, "\r\nSPWF> error enabling HW flow control\r\n");
             return false;
@@ -130,7 +180,7 @@ bool SPWFSAxx::startup(int mode)
         _serial.set_flow_control(SerialBase::RTSCTS, _rts, _cts);
     } else {
         /*disable HW flow control*/
-        if(!(_parser.send(SPWFXX_SEND_DISABLE_FC) && _recv_ok()))
+        if(!(_send_cmd(SPWFXX_SEND_DISABLE_FC) && _recv_ok()))
         {
             debug_if(_dbg_on, "\r\nSPWF> error disabling HW flow control\r\n");
             return false;
@@ -140,7 +190,7 @@ bool SPWFSAxx::startup(int mode)
 #else // !defined(MBED_MAJOR_VERSION) - Assuming `master` branch
 #if !DEVICE_SERIAL_FC
     /*disable HW flow control*/
-    if(!(_parser.send(SPWFXX_SEND_DISABLE_FC) && _recv_ok()))
+    if(!(_send_cmd(SPWFXX_SEND_DISABLE_FC) && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error disabling HW flow control\r\n");
         return false;
@@ -148,7 +198,7 @@ bool SPWFSAxx::startup(int mode)
 #else // DEVICE_SERIAL_FC
     if((_rts != NC) && (_cts != NC)) {
         /*enable HW flow control*/
-        if(!(_parser.send(SPWFXX_SEND_ENABLE_FC) && _recv_ok()))
+        if(!(_send_cmd(SPWFXX_SEND_ENABLE_FC) && _recv_ok()))
         {
             debug_if(_dbg_on, "\r\nSPWF> error enabling HW flow control\r\n");
             return false;
@@ -158,7 +208,7 @@ bool SPWFSAxx::startup(int mode)
         _serial.set_flow_control(SerialBase::RTSCTS, _rts, _cts);
     } else {
         /*disable HW flow control*/
-        if(!(_parser.send(SPWFXX_SEND_DISABLE_FC) && _recv_ok()))
+        if(!(_send_cmd(SPWFXX_SEND_DISABLE_FC) && _recv_ok()))
         {
             debug_if(_dbg_on, "\r\nSPWF> error disabling HW flow control\r\n");
             return false;
@@ -170,26 +220,53 @@ bool SPWFSAxx::startup(int mode)
     /* Disable selected WINDs */
     _winds_on();
 
+#if SPWFXX_BAUD_RATE != SPWFXX_DEFAULT_BAUD_RATE
+    if(upgrade_speed && _send_cmd(SPWFXX_SEND_SET_CONS_SPEED "%d", SPWFXX_BAUD_RATE) && _recv_ok()) {
+        /* try out upgraded console speed (becomes active with following sw reset) before saving it to flash */
+        if(!(reset(SPWFXX_BAUD_RATE, false) && _check_link())) {
+            /* module not reachable with upgraded console speed: HW reset makes module forget about it
+             * (or brings it up with the speed saved in flash, see retry above), start over with default speed */
+            debug_if(_dbg_on, "\r\nSPWF> console speed %d not working, falling back to %d\r\n",
+                     SPWFXX_BAUD_RATE, SPWFXX_DEFAULT_BAUD_RATE);
+            _set_baud_rate(SPWFXX_DEFAULT_BAUD_RATE);
+            return _startup(mode, false);
+        }
+
+        /* save current setting in flash */
+        reset_ok = (_send_cmd(SPWFXX_SEND_SAVE_SETTINGS) && _recv_ok());
+    } else {
+        if(upgrade_speed) {
+            debug_if(_dbg_on, "\r\nSPWF> error setting console speed, keeping default one\r\n");
+        }
+
+        /* sw reset (factory default console speed, even if module came up with the upgraded one) */
+        reset_ok = reset(SPWFXX_DEFAULT_BAUD_RATE);
+    }
+#else // SPWFXX_BAUD_RATE == SPWFXX_DEFAULT_BAUD_RATE
+    (void)upgrade_speed; // nothing to upgrade
+
     /* sw reset */
-    if(!reset()) {
+    reset_ok = reset();
+#endif // SPWFXX_BAUD_RATE == SPWFXX_DEFAULT_BAUD_RATE
+    if(!reset_ok) {
         debug_if(_dbg_on, "\r\nSPWF> SW reset failed (%s, %d)\r\n", __func__, __LINE__);
         return false;
     }
 
 #ifndef NDEBUG
-    if (!(_parser.send(SPWFXX_SEND_GET_CONS_STATE)
+    if (!(_send_cmd(SPWFXX_SEND_GET_CONS_STATE)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> error getting console state\r\n");
         return false;
     }
 
-    if (!(_parser.send(SPWFXX_SEND_GET_CONS_SPEED)
+    if (!(_send_cmd(SPWFXX_SEND_GET_CONS_SPEED)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> error getting console speed\r\n");
         return false;
     }
 
-    if (!(_parser.send(SPWFXX_SEND_GET_HWFC_STATE)
+    if (!(_send_cmd(SPWFXX_SEND_GET_HWFC_STATE)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> error getting hwfc state\r\n");
         return false;
@@ -199,102 +276,114 @@ bool SPWFSAxx::startup(int mode)
     /* betzw: IDW01M1 FW versions <3.5 seem to have problems with the following two commands.
      *        For the sake of simplicity, just excluding them for IDW01M1 in general.
      */
-    if (!(_parser.send(SPWFXX_SEND_GET_CONS_DELIM)
+    if (!(_send_cmd(SPWFXX_SEND_GET_CONS_DELIM)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> error getting console delimiter\r\n");
         return false;
     }
 
-    if (!(_parser.send(SPWFXX_SEND_GET_CONS_ERRS)
+    if (!(_send_cmd(SPWFXX_SEND_GET_CONS_ERRS)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> error getting console error setting\r\n");
         return false;
     }
 #endif // (MBED_CONF_IDW0XX1_EXPANSION_BOARD == IDW04A1) || defined(IDW01M1_FW_REL_35X)
 
-    if (!(_parser.send("AT+S.GCFG=sleep_enabled")
+    if (!(_send_cmd("AT+S.GCFG=sleep_enabled")
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> error getting sleep state enabled\r\n");
         return false;
     }
 
-    if (!(_parser.send("AT+S.GCFG=wifi_powersave")
+    if (!(_send_cmd("AT+S.GCFG=wifi_powersave")
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> error getting powersave mode\r\n");
         return false;
     }
 
-    if (!(_parser.send("AT+S.GCFG=standby_enabled")
+    if (!(_send_cmd("AT+S.GCFG=standby_enabled")
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> error getting standby state enabled\r\n");
         return false;
     }
 #endif
 
+    /* module configuration has been reset to factory defaults */
+    _cfg_valid = false;
+    _radio_off = false;
+
+    /* fill MAC address cache */
+    _cache_valid_bitmap = 0;
+    getMACAddress();
+
     return true;
 }
 
-bool SPWFSAxx::_wait_console_active(void) {
-    int trials = 0;
+/* wait (at most `_timeout` overall) for `+WIND:<code>` (dispatching other asynchronous indications) */
+bool SPWFSAxx::_wait_wind(int code) {
+    Timer timer;
+
+    _winds_restore();
+
+    timer.start();
 
     while(true) {
-        if (_parser.recv("+WIND:0:Console active\n") && _recv_delim_lf()) {
-            debug_if(_dbg_on, "AT^ +WIND:0:Console active\r\n");
-            return true;
-        }
-        if(++trials >= SPWFXX_MAX_TRIALS) {
-            debug("\r\nSPWF> ERROR: Should never happen! (%s, %d)\r\n", __func__, __LINE__);
+        SpwfProtocolEngine::event_t evt = _recv_event_until(timer, _timeout);
+
+        if(evt == SpwfProtocolEngine::EVT_NONE) {
+            debug_if(_dbg_on, "\r\nSPWF> timeout waiting for WIND (%s, %d, %d)\r\n", __func__, code, __LINE__);
             empty_rx_buffer();
             return false;
         }
-    }
-}
-
-bool SPWFSAxx::_wait_wifi_hw_started(void) {
-    int trials = 0;
 
-    while(true) {
-        if (_parser.recv("+WIND:32:WiFi Hardware Started\n") && _recv_delim_lf()) {
-            debug_if(_dbg_on, "AT^ +WIND:32:WiFi Hardware Started\r\n");
+        if((evt == SpwfProtocolEngine::EVT_WIND) && (_engine.wind_code() == code)) {
+            debug_if(_dbg_on, "AT^ %s\r\n", _engine.line());
             return true;
         }
-        if(++trials >= SPWFXX_MAX_TRIALS) {
-            debug("\r\nSPWF> ERROR: Should never happen! (%s, %d)\r\n", __func__, __LINE__);
-            empty_rx_buffer();
-            return false;
-        }
+
+        _dispatch_event(evt);
     }
 }
 
 bool SPWFSAxx::hw_reset(void)
 {
+    _winds_held = false; // module restarts with WINDs switched on
 #if (MBED_CONF_IDW0XX1_EXPANSION_BOARD != IDW04A1) || !defined(IDW04A1_WIFI_HW_BUG_WA) // betzw: HW reset doesn't work as expected on unmodified X_NUCLEO_IDW04A1 expansion boards
     _reset.write(0);
     wait_ms(200);
     _reset.write(1); 
 #else // (MBED_CONF_IDW0XX1_EXPANSION_BOARD == IDW04A1) && defined(IDW04A1_WIFI_HW_BUG_WA): substitute with SW reset
-    _parser.send(SPWFXX_SEND_SW_RESET);
+    _send_cmd(SPWFXX_SEND_SW_RESET);
 #endif // (MBED_CONF_IDW0XX1_EXPANSION_BOARD == IDW04A1) && defined(IDW04A1_WIFI_HW_BUG_WA)
     return _wait_console_active();
 }
 
-bool SPWFSAxx::reset(void)
+bool SPWFSAxx::reset(int baud_rate, bool save)
 {
     bool ret;
 
+    /* do not save (nor keep) held WINDs switched off */
+    _winds_restore();
+
     /* save current setting in flash */
-    if(!(_parser.send(SPWFXX_SEND_SAVE_SETTINGS) && _recv_ok()))
+    if(save && !(_send_cmd(SPWFXX_SEND_SAVE_SETTINGS) && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error saving configuration to flash (%s, %d)\r\n", __func__, __LINE__);
         return false;
     }
 
-    if(!_parser.send(SPWFXX_SEND_SW_RESET)) return false; /* betzw - NOTE: "keep the current state and reset the device".
+    if(!_send_cmd(SPWFXX_SEND_SW_RESET)) return false; /* betzw - NOTE: "keep the current state and reset the device".
                                                                      We assume that the module informs us about the
                                                                      eventual closing of sockets via "WIND" asynchronous
                                                                      indications! So everything regarding the clean-up
                                                                      of these situations is handled there. */
 
+    if((baud_rate > 0) && (baud_rate != _baud_rate)) { /* module restarts with new console speed */
+        _serial.sync(); // let reset command get out with old speed
+        wait_ms(1);
+        _set_baud_rate(baud_rate);
+    }
+
     /* waiting for HW to start */
     ret = _wait_wifi_hw_started();
 
@@ -308,77 +397,197 @@ bool SPWFSAxx::reset(void)
  */
 bool SPWFSAxx::connect(const char *ap, const char *passPhrase, int securityMode)
 {
-    int trials;
-
     BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
                                  Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
 
-    //AT+S.SCFG=wifi_wpa_psk_text,%s
-    if(!(_parser.send("AT+S.SCFG=wifi_wpa_psk_text,%s", passPhrase) && _recv_ok()))
-    {
-        debug_if(_dbg_on, "\r\nSPWF> error pass set\r\n");
+    if(!_connect_start(ap, passPhrase, securityMode)) {
         return false;
-    } 
+    }
 
-    //AT+S.SSIDTXT=%s
-    if(!(_parser.send("AT+S.SSIDTXT=%s", ap) && _recv_ok()))
-    {
-        debug_if(_dbg_on, "\r\nSPWF> error ssid set\r\n");
+    return _wait_wifi_up();
+}
+
+bool SPWFSAxx::connectStart(const char *ap, const char *passPhrase, int securityMode)
+{
+    BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
+                                 Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
+
+    if(!_connect_start(ap, passPhrase, securityMode)) {
         return false;
     }
 
-    //AT+S.SCFG=wifi_priv_mode,%d
-    if(!(_parser.send("AT+S.SCFG=wifi_priv_mode,%d", securityMode) && _recv_ok()))
-    {
-        debug_if(_dbg_on, "\r\nSPWF> error security mode set\r\n");
-        return false;
+    /* association might have been completed already in the meantime */
+    _process_winds();
+    if(_assoc_state == SPWFSA_ASSOC_UP) {
+        _assoc_completed();
+    }
+
+    return true;
+}
+
+spwfsa_assoc_state_t SPWFSAxx::pollAssociation(void)
+{
+    BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
+                                 Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
+
+    spwfsa_assoc_state_t state;
+
+    if(!_assoc_pending()) return _assoc_state;
+
+    _winds_restore(); // association is driven by WINDs
+    _process_winds();
+
+    state = _assoc_state;
+    if(state == SPWFSA_ASSOC_UP) {
+        _assoc_completed();
+    } else if(state == SPWFSA_ASSOC_FAILED) {
+        disconnect(); // resets association state
+        empty_rx_buffer();
+    }
+
+    return state;
+}
+
+/* Configure module for connecting to `ap` (skipping unchanged settings) & (re-)start it in STA mode */
+bool SPWFSAxx::_connect_start(const char *ap, const char *passPhrase, int securityMode)
+{
+    const char *pass = (passPhrase != NULL) ? passPhrase : ""; // `NULL` for open networks
+    bool cfg_unchanged = _cfg_valid
+            && (strcmp(_cfg_ssid, ap) == 0)
+            && (strcmp(_cfg_pass, pass) == 0)
+            && (_cfg_sec_mode == securityMode);
+
+    _winds_restore(); // association is driven by WINDs
+    _cache_invalidate_net();
+    memset(&_connect_timing, 0, sizeof(_connect_timing));
+    _connect_timing.startup_ms = _startup_ms; // `startup()` run by this connect (if any)
+    _startup_ms = 0;
+    _connect_timer.reset();
+    _connect_timer.start();
+    _assoc_state = SPWFSA_ASSOC_IDLE;
+    _assoc_deauths = 0;
+
+#if SPWFSA_FAST_RECONNECT
+    if(cfg_unchanged && _radio_off) {
+        /* module is still configured for STA mode, just switch radio on again */
+        if(!(_send_cmd("AT+S.WIFI=1") && _recv_ok()))
+        {
+            debug_if(_dbg_on, "\r\nSPWF> error enabling WiFi\r\n");
+            return false;
+        }
+        _radio_off = false;
+
+        _connect_timing.fast = true;
+        _connect_timing.config_ms = _connect_timer.read_ms();
+        _assoc_state = SPWFSA_ASSOC_ONGOING;
+        return true;
+    }
+#endif // SPWFSA_FAST_RECONNECT
+
+    if(!cfg_unchanged) {
+        _cfg_valid = false;
+
+        //AT+S.SCFG=wifi_wpa_psk_text,%s
+        if(!(_send_cmd("AT+S.SCFG=wifi_wpa_psk_text,%s", pass) && _recv_ok()))
+        {
+            debug_if(_dbg_on, "\r\nSPWF> error pass set\r\n");
+            return false;
+        }
+
+        //AT+S.SSIDTXT=%s
+        if(!(_send_cmd("AT+S.SSIDTXT=%s", ap) && _recv_ok()))
+        {
+            debug_if(_dbg_on, "\r\nSPWF> error ssid set\r\n");
+            return false;
+        }
+
+        //AT+S.SCFG=wifi_priv_mode,%d
+        if(!(_send_cmd("AT+S.SCFG=wifi_priv_mode,%d", securityMode) && _recv_ok()))
+        {
+            debug_if(_dbg_on, "\r\nSPWF> error security mode set\r\n");
+            return false;
+        }
     }
 
     /*set STA mode (0->idle, 1->STA,3->miniAP, 2->IBSS)*/
-    if(!(_parser.send("AT+S.SCFG=wifi_mode,1") && _recv_ok()))
+    if(!(_send_cmd("AT+S.SCFG=wifi_mode,1") && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error WiFi mode set 1 (STA)\r\n");
         return false;
     }
 
+#if SPWFSA_FAST_RECONNECT
+    if(_radio_off) {
+        /*enable Wi-Fi device*/
+        if(!(_send_cmd("AT+S.WIFI=1") && _recv_ok()))
+        {
+            debug_if(_dbg_on, "\r\nSPWF> error enabling WiFi\r\n");
+            return false;
+        }
+        _radio_off = false;
+    }
+#endif // SPWFSA_FAST_RECONNECT
+
+    _connect_timing.config_ms = _connect_timer.read_ms();
+
     /* sw reset */
     if(!reset()) {
         debug_if(_dbg_on, "\r\nSPWF> SW reset failed (%s, %d)\r\n", __func__, __LINE__);
         return false;
     }
 
-    trials = 0;
-    while(true) {
-        if(_parser.recv("%255[^\n]\n", _msg_buffer) && _recv_delim_lf())
-        {
-            if(strstr(_msg_buffer, ":24:") != NULL) { // WiFi Up
-                debug_if(_dbg_on, "AT^ %s\n", _msg_buffer);
-                if(strchr(_msg_buffer, '.') != NULL) { // IPv4 address
-                    break;
-                } else {
-                    continue;
-                }
-            }
-            if(strstr(_msg_buffer, ":40:") != NULL) { // Deauthentication
-                debug_if(_dbg_on, "AT~ %s\n", _msg_buffer);
-                if(++trials < SPWFXX_MAX_TRIALS) { // give it three trials
-                    continue;
-                }
-                disconnect();
-                empty_rx_buffer();
-                return false;
-            } else {
-                debug_if(_dbg_on, "AT] %s\n", _msg_buffer);
-            }
-            continue;
-        }
-        if(++trials >= SPWFXX_MAX_TRIALS) {
-            debug("\r\nSPWF> ERROR: Should never happen! (%s, %d)\r\n", __func__, __LINE__);
+    _connect_timing.reset_ms = _connect_timer.read_ms() - _connect_timing.config_ms;
+
+    /* remember credentials stored in module configuration */
+    if((strlen(ap) < sizeof(_cfg_ssid)) && (strlen(pass) < sizeof(_cfg_pass))) {
+        strcpy(_cfg_ssid, ap);
+        strcpy(_cfg_pass, pass);
+        _cfg_sec_mode = securityMode;
+        _cfg_valid = true;
+    }
+
+    _assoc_state = SPWFSA_ASSOC_ONGOING;
+    return true;
+}
+
+void SPWFSAxx::_assoc_completed(void)
+{
+    if(_network_lost_flag) { // re-association after network loss, keep timing of last connect
+        _connect_timer.stop();
+        return;
+    }
+
+    _connect_timing.join_ms = _connect_timer.read_ms() - _connect_timing.config_ms - _connect_timing.reset_ms;
+    _connect_timing.total_ms = _connect_timing.startup_ms + _connect_timer.read_ms();
+    _connect_timer.stop();
+
+    debug_if(_dbg_on, "\r\nSPWF> connect timing (fast=%d): startup %ums, config %ums, reset %ums, join %ums\r\n",
+             _connect_timing.fast, _connect_timing.startup_ms, _connect_timing.config_ms,
+             _connect_timing.reset_ms, _connect_timing.join_ms);
+}
+
+/* wait for association & IP address (`+WIND:24`), the whole connect being bounded by `SPWF_CONNECT_TIMEOUT` */
+bool SPWFSAxx::_wait_wifi_up(void)
+{
+    while(_assoc_pending()) {
+        SpwfProtocolEngine::event_t evt = _recv_event_until(_connect_timer, SPWF_CONNECT_TIMEOUT);
+
+        if(evt == SpwfProtocolEngine::EVT_NONE) {
+            debug_if(_dbg_on, "\r\nSPWF> association timed out (%s, %d)\r\n", __func__, __LINE__);
+            disconnect();
             empty_rx_buffer();
             return false;
         }
+        _dispatch_event(evt);
+    }
+
+    if(_assoc_state != SPWFSA_ASSOC_UP) { // too many deauthentications
+        disconnect();
+        empty_rx_buffer();
+        return false;
     }
 
+    _assoc_completed();
     return true;
 }
 
@@ -387,9 +596,33 @@ bool SPWFSAxx::disconnect(void)
     BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
                                  Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
 
+    _assoc_state = SPWFSA_ASSOC_IDLE; // abort pending association or network loss recovery (if any)
+    _network_lost_flag = false;
+
+#if SPWFSA_FAST_RECONNECT
+    if(_cfg_valid && !_radio_off) {
+        /* just switch radio off, keeping STA configuration (w/o flash write & reset) for a fast reconnect */
+        if(!(_send_cmd("AT+S.WIFI=0") && _recv_ok()))
+        {
+            debug_if(_dbg_on, "\r\nSPWF> error disabling WiFi\r\n");
+            return false;
+        }
+        _radio_off = true;
+
+        /* clean up state (module stays initialized) */
+        _associated_interface.inner_constructor(false);
+        _free_all_packets();
+        _cache_invalidate_net();
+        _closing_sockets_bitmap = 0;
+
+        return true;
+    }
+
+#endif // SPWFSA_FAST_RECONNECT
+
 #if MBED_CONF_IDW0XX1_EXPANSION_BOARD == IDW04A1
-    /*disable Wi-Fi device*/
-    if(!(_parser.send("AT+S.WIFI=0") && _recv_ok()))
+    /*disable Wi-Fi device (unless already done by a fast disconnect)*/
+    if(!_radio_off && !(_send_cmd("AT+S.WIFI=0") && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error disabling WiFi\r\n");
         return false;
@@ -397,7 +630,7 @@ bool SPWFSAxx::disconnect(void)
 #endif // IDW04A1
 
     /*set idle mode (0->idle, 1->STA,3->miniAP, 2->IBSS)*/
-    if(!(_parser.send("AT+S.SCFG=wifi_mode,0") && _recv_ok()))
+    if(!(_send_cmd("AT+S.SCFG=wifi_mode,0") && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error WiFi mode set idle (%d)\r\n", __LINE__);
         return false;
@@ -405,11 +638,12 @@ bool SPWFSAxx::disconnect(void)
 
 #if MBED_CONF_IDW0XX1_EXPANSION_BOARD == IDW04A1
     /*enable Wi-Fi device*/
-    if(!(_parser.send("AT+S.WIFI=1") && _recv_ok()))
+    if(!(_send_cmd("AT+S.WIFI=1") && _recv_ok()))
     {
         debug_if(_dbg_on, "\r\nSPWF> error enabling WiFi\r\n");
         return false;
     }
+    _radio_off = false;
 #endif // IDW04A1
 
     // reset module
@@ -421,18 +655,31 @@ bool SPWFSAxx::disconnect(void)
     /* clean up state */
     _associated_interface.inner_constructor();
     _free_all_packets();
+    _cache_invalidate_net();
+    _closing_sockets_bitmap = 0;
 
     return true;
 }
 
+/* maximum age (in ms) of cached values, indexed by `spwfsa_cache_field_t` */
+const uint32_t SPWFSAxx::_cache_timeouts[SPWFSA_CACHE_COUNT] = {
+    SPWFSA_IP_CACHE_TIMEOUT,
+    SPWFSA_GATEWAY_CACHE_TIMEOUT,
+    SPWFSA_NETMASK_CACHE_TIMEOUT,
+    SPWFSA_RSSI_CACHE_TIMEOUT,
+    SPWFSA_CACHE_NO_TIMEOUT,
+};
+
 const char *SPWFSAxx::getIPAddress(void)
 {
     unsigned int n1, n2, n3, n4;
 
+    if(_cache_is_fresh(SPWFSA_CACHE_IP)) return _ip_buffer;
+
     BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
                                  Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
 
-    if (!(_parser.send("AT+S.STS=ip_ipaddr")
+    if (!(_send_cmd("AT+S.STS=ip_ipaddr")
             && _parser.recv(SPWFXX_RECV_IP_ADDR, &n1, &n2, &n3, &n4)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> get IP address error\r\n");
@@ -441,7 +688,12 @@ const char *SPWFSAxx::getIPAddress(void)
 
     debug_if(_dbg_on, "AT^ ip_ipaddr = %u.%u.%u.%u\r\n", n1, n2, n3, n4);
 
-    sprintf((char*)_ip_buffer,"%u.%u.%u.%u", n1, n2, n3, n4);
+    {
+        CACHE_SYNC_HANDLER;
+
+        sprintf((char*)_ip_buffer,"%u.%u.%u.%u", n1, n2, n3, n4);
+        _cache_update(SPWFSA_CACHE_IP);
+    }
     return _ip_buffer;
 }
 
@@ -449,10 +701,12 @@ const char *SPWFSAxx::getGateway(void)
 {
     unsigned int n1, n2, n3, n4;
 
+    if(_cache_is_fresh(SPWFSA_CACHE_GATEWAY)) return _gateway_buffer;
+
     BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
                                  Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
 
-    if (!(_parser.send("AT+S.STS=ip_gw")
+    if (!(_send_cmd("AT+S.STS=ip_gw")
             && _parser.recv(SPWFXX_RECV_GATEWAY, &n1, &n2, &n3, &n4)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> get gateway error\r\n");
@@ -461,7 +715,12 @@ const char *SPWFSAxx::getGateway(void)
 
     debug_if(_dbg_on, "AT^ ip_gw = %u.%u.%u.%u\r\n", n1, n2, n3, n4);
 
-    sprintf((char*)_gateway_buffer,"%u.%u.%u.%u", n1, n2, n3, n4);
+    {
+        CACHE_SYNC_HANDLER;
+
+        sprintf((char*)_gateway_buffer,"%u.%u.%u.%u", n1, n2, n3, n4);
+        _cache_update(SPWFSA_CACHE_GATEWAY);
+    }
     return _gateway_buffer;
 }
 
@@ -469,10 +728,12 @@ const char *SPWFSAxx::getNetmask(void)
 {
     unsigned int n1, n2, n3, n4;
 
+    if(_cache_is_fresh(SPWFSA_CACHE_NETMASK)) return _netmask_buffer;
+
     BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
                                  Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
 
-    if (!(_parser.send("AT+S.STS=ip_netmask")
+    if (!(_send_cmd("AT+S.STS=ip_netmask")
             && _parser.recv(SPWFXX_RECV_NETMASK, &n1, &n2, &n3, &n4)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> get netmask error\r\n");
@@ -481,35 +742,330 @@ const char *SPWFSAxx::getNetmask(void)
 
     debug_if(_dbg_on, "AT^ ip_netmask = %u.%u.%u.%u\r\n", n1, n2, n3, n4);
 
-    sprintf((char*)_netmask_buffer,"%u.%u.%u.%u", n1, n2, n3, n4);
+    {
+        CACHE_SYNC_HANDLER;
+
+        sprintf((char*)_netmask_buffer,"%u.%u.%u.%u", n1, n2, n3, n4);
+        _cache_update(SPWFSA_CACHE_NETMASK);
+    }
     return _netmask_buffer;
 }
 
-int8_t SPWFSAxx::getRssi(void)
+int8_t SPWFSAxx::getRssi(bool refresh)
 {
     int ret;
 
+    if(!refresh && _cache_is_fresh(SPWFSA_CACHE_RSSI)) return _rssi;
+
     BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
                                  Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
 
-    if (!(_parser.send("AT+S.PEERS=0,rx_rssi")
+    if (!(_send_cmd("AT+S.PEERS=0,rx_rssi")
             && _parser.recv(SPWFXX_RECV_RX_RSSI, &ret)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> get RX rssi error\r\n");
         return 0;
     }
 
-    return (int8_t)ret;
+    {
+        CACHE_SYNC_HANDLER;
+
+        _rssi = (int8_t)ret;
+        _cache_update(SPWFSA_CACHE_RSSI);
+    }
+    return _rssi;
+}
+
+/* Copy fresh cached value of `field` into `value` (w/o taking the driver (UART) lock),
+ * returns false if there is no fresh value cached */
+bool SPWFSAxx::_cache_read(spwfsa_cache_field_t field, void *value)
+{
+    CACHE_SYNC_HANDLER;
+
+    if(!_cache_is_fresh(field)) return false;
+
+    switch(field) {
+        case SPWFSA_CACHE_IP:
+            strcpy((char*)value, _ip_buffer);
+            break;
+        case SPWFSA_CACHE_GATEWAY:
+            strcpy((char*)value, _gateway_buffer);
+            break;
+        case SPWFSA_CACHE_NETMASK:
+            strcpy((char*)value, _netmask_buffer);
+            break;
+        case SPWFSA_CACHE_MAC:
+            strcpy((char*)value, _mac_buffer);
+            break;
+        case SPWFSA_CACHE_RSSI:
+            *(int8_t*)value = _rssi;
+            break;
+        default:
+            MBED_ASSERT(false);
+            return false;
+    }
+
+    return true;
+}
+
+void SPWFSAxx::getPacketPoolStats(unsigned int *max_used, unsigned int *exhausted)
+{
+    PKT_SYNC_HANDLER;
+
+    *max_used = _packet_pool.max_used();
+    *exhausted = _packet_pool.exhausted();
+}
+
+void SPWFSAxx::getRecvStats(uint32_t *at_cmds, uint32_t *bytes)
+{
+    *at_cmds = _rx_at_cmd_cnt;
+    *bytes = _rx_bytes_cnt;
+}
+
+bool SPWFSAxx::getAtLatencyStats(spwfsa_at_class_t cmd_class, spwfsa_at_latency_t *stats)
+{
+#if SPWFSA_AT_LATENCY_STATS
+    if(((unsigned int)cmd_class) >= ((unsigned int)SPWFSA_AT_CLASS_COUNT)) return false;
+
+    *stats = _at_latency[cmd_class];
+    return true;
+#else // !SPWFSA_AT_LATENCY_STATS
+    return false;
+#endif // !SPWFSA_AT_LATENCY_STATS
+}
+
+void SPWFSAxx::resetAtLatencyStats(void)
+{
+#if SPWFSA_AT_LATENCY_STATS
+    memset(_at_latency, 0, sizeof(_at_latency));
+    _at_latency_class = -1;
+#endif // SPWFSA_AT_LATENCY_STATS
+}
+
+unsigned int SPWFSAxx::readTrace(spwfsa_trace_event_t *events, unsigned int count)
+{
+#if SPWFSA_TRACE_SIZE > 0
+    unsigned int read = 0;
+    uint32_t wr = _trace_wr;
+
+    if((wr - _trace_rd) > SPWFSA_TRACE_SIZE) { // reader has been overtaken: skip overwritten events
+        _trace_rd = wr - SPWFSA_TRACE_SIZE;
+    }
+
+    while((read < count) && (_trace_rd != wr)) {
+        events[read++] = _trace_buf[_trace_rd++ & (SPWFSA_TRACE_SIZE - 1)];
+    }
+
+    return read;
+#else // SPWFSA_TRACE_SIZE == 0
+    return 0;
+#endif // SPWFSA_TRACE_SIZE == 0
+}
+
+bool SPWFSAxx::_send_cmd(const char *command, ...)
+{
+    va_list args;
+    bool ret;
+
+#if SPWFSA_AT_LATENCY_STATS
+    _at_latency_start(command);
+#endif // SPWFSA_AT_LATENCY_STATS
+
+    va_start(args, command);
+    ret = _parser.vsend(command, args);
+    va_end(args);
+
+    return ret;
+}
+
+/* Note: returns `EVT_NONE` only in case of timeout */
+SpwfProtocolEngine::event_t SPWFSAxx::_recv_event(void)
+{
+    SpwfProtocolEngine::event_t evt;
+
+    do {
+        int c = _parser.getc();
+        if(c < 0) { // timeout
+            debug_if(_dbg_on && _engine.in_line(), "\r\nSPWF> incomplete line dropped (%s, %d)\r\n", __func__, __LINE__);
+            _engine.reset();
+            return SpwfProtocolEngine::EVT_NONE;
+        }
+        evt = _engine.feed(c);
+    } while(evt == SpwfProtocolEngine::EVT_NONE);
+
+    /* consume line feed (to not leave it in front of eventually following binary data) */
+    _recv_delim_lf();
+
+    return evt;
+}
+
+/* receive next event, but give up once `timer` has reached `deadline_ms` */
+SpwfProtocolEngine::event_t SPWFSAxx::_recv_event_until(Timer &timer, uint32_t deadline_ms)
+{
+    SpwfProtocolEngine::event_t evt;
+    int remaining = (int)deadline_ms - timer.read_ms();
+
+    if(remaining <= 0) {
+        return SpwfProtocolEngine::EVT_NONE;
+    }
+
+    _parser.set_timeout(remaining);
+    evt = _recv_event();
+    _parser.set_timeout(_timeout);
+
+    return evt;
+}
+
+/* wait for final `OK` of a command (dispatching asynchronous indications received in the meantime) */
+bool SPWFSAxx::_recv_ok(void)
+{
+    while(true) {
+        SpwfProtocolEngine::event_t evt = _recv_event();
+
+        switch(evt) {
+            case SpwfProtocolEngine::EVT_OK:
+#if SPWFSA_AT_LATENCY_STATS
+                _at_latency_stop();
+#endif // SPWFSA_AT_LATENCY_STATS
+                return true;
+            case SpwfProtocolEngine::EVT_NONE:
+                return false;
+            case SpwfProtocolEngine::EVT_ERROR:
+                _error_handler();
+                return false;
+            default:
+                _dispatch_event(evt);
+                break;
+        }
+    }
+}
+
+void SPWFSAxx::_dispatch_event(SpwfProtocolEngine::event_t evt)
+{
+    switch(evt) {
+        case SpwfProtocolEngine::EVT_WIND:
+            _dispatch_wind();
+            break;
+        case SpwfProtocolEngine::EVT_ERROR:
+            _error_handler();
+            break;
+        case SpwfProtocolEngine::EVT_REPLY:
+            debug_if(_dbg_on, "AT] %s\r\n", _engine.line());
+            break;
+        default:
+            break;
+    }
+}
+
+/* Note: handlers must parse `args` before issuing any further AT command */
+const SPWFSAxx::wind_handler_t SPWFSAxx::_wind_handlers[SPWFXX_WIND_CODES] = {
+    /*  0 */ NULL, NULL, NULL, NULL, NULL,
+    /*  5 */ &SPWFSAxx::_wifi_hwfault_handler, // WiFi Hardware Failure
+    /*  6 */ NULL, NULL,
+    /*  8 */ &SPWFSAxx::_hard_fault_handler, // Hard Fault
+    /*  9 */ NULL,
+    /* 10 */ NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    /* 20 */ NULL, NULL, NULL, NULL,
+    /* 24 */ &SPWFSAxx::_wifi_up_handler, // WiFi Up
+    /* 25 */ NULL, NULL, NULL, NULL, NULL,
+    /* 30 */ NULL, NULL, NULL,
+    /* 33 */ &SPWFSAxx::_network_lost_handler_th, // WiFi Network Lost
+    /* 34 */ NULL, NULL, NULL, NULL, NULL, NULL,
+    /* 40 */ &SPWFSAxx::_deauth_handler, // WiFi Deauthentication
+    /* 41 */ NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    /* 50 */ NULL, NULL, NULL, NULL, NULL,
+    /* 55 */ &SPWFSAxx::_packet_handler_th, // Pending Data
+    /* 56 */ NULL, NULL,
+    /* 58 */ &SPWFSAxx::_server_gone_handler, // Socket Closed
+    /* 59 */ NULL,
+    /* 60 */ NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    /* 70 */ NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    /* 80 */ NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+};
+
+void SPWFSAxx::_dispatch_wind(void)
+{
+    unsigned int code = (unsigned int)_engine.wind_code();
+    wind_handler_t handler = (code < SPWFXX_WIND_CODES) ? _wind_handlers[code] : NULL;
+
+    if(handler != NULL) {
+        (this->*handler)(_engine.args());
+    } else {
+        debug_if(_dbg_on, "AT^ %s\r\n", _engine.line());
+    }
+}
+
+#if SPWFSA_AT_LATENCY_STATS
+static const struct {
+    const char *name;
+    spwfsa_at_class_t cmd_class;
+} at_latency_classes[] = {
+    { "SOCKW",  SPWFSA_AT_SOCKW },
+    { "SOCKR",  SPWFSA_AT_SOCKR },
+    { "SOCKQ",  SPWFSA_AT_SOCKQ },
+    { "SOCKON", SPWFSA_AT_SOCKON },
+    { "SOCKC",  SPWFSA_AT_SOCKC },
+    { "STS",    SPWFSA_AT_STS },
+    { "SCFG",   SPWFSA_AT_SCFG },
+    { "GCFG",   SPWFSA_AT_GCFG },
+    { "WIFI",   SPWFSA_AT_WIFI },
+    { "SCAN",   SPWFSA_AT_SCAN },
+};
+
+static const uint32_t at_latency_bounds_us[SPWFSA_AT_LATENCY_BUCKETS - 1] = {
+    250, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000, 500000, 1000000
+};
+
+void SPWFSAxx::_at_latency_start(const char *command)
+{
+    static const char prefix[] = "AT+S.";
+
+    _at_latency_class = SPWFSA_AT_OTHER;
+    _at_latency_start_us = us_ticker_read();
+
+    if(strncmp(command, prefix, sizeof(prefix) - 1) != 0) return;
+    command += sizeof(prefix) - 1;
+
+    for(unsigned int i = 0; i < (sizeof(at_latency_classes) / sizeof(at_latency_classes[0])); i++) {
+        size_t len = strlen(at_latency_classes[i].name);
+
+        if((strncmp(command, at_latency_classes[i].name, len) == 0) &&
+                ((command[len] == '=') || (command[len] == '\0'))) {
+            _at_latency_class = at_latency_classes[i].cmd_class;
+            return;
+        }
+    }
+}
+
+void SPWFSAxx::_at_latency_stop(void)
+{
+    uint32_t elapsed_us = us_ticker_read() - _at_latency_start_us;
+    unsigned int bucket;
+
+    if(_at_latency_class < 0) return; // `OK` without (measured) command
+
+    spwfsa_at_latency_t &lat = _at_latency[_at_latency_class];
+    _at_latency_class = -1;
+
+    for(bucket = 0; (bucket < (SPWFSA_AT_LATENCY_BUCKETS - 1)) && (elapsed_us >= at_latency_bounds_us[bucket]); bucket++);
+
+    lat.buckets[bucket]++;
+    lat.count++;
+    lat.total_us += elapsed_us;
+    if(elapsed_us > lat.max_us) lat.max_us = elapsed_us;
 }
+#endif // SPWFSA_AT_LATENCY_STATS
 
 const char *SPWFSAxx::getMACAddress(void)
 {
     unsigned int n1, n2, n3, n4, n5, n6;
 
+    if(_cache_is_fresh(SPWFSA_CACHE_MAC)) return _mac_buffer;
+
     BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
                                  Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
 
-    if (!(_parser.send("AT+S.GCFG=nv_wifi_macaddr")
+    if (!(_send_cmd("AT+S.GCFG=nv_wifi_macaddr")
             && _parser.recv(SPWFXX_RECV_MAC_ADDR, &n1, &n2, &n3, &n4, &n5, &n6)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> get MAC address error\r\n");
@@ -518,7 +1074,12 @@ const char *SPWFSAxx::getMACAddress(void)
 
     debug_if(_dbg_on, "AT^ nv_wifi_macaddr = %x:%x:%x:%x:%x:%x\r\n", n1, n2, n3, n4, n5, n6);
 
-    sprintf((char*)_mac_buffer,"%02X:%02X:%02X:%02X:%02X:%02X", n1, n2, n3, n4, n5, n6);
+    {
+        CACHE_SYNC_HANDLER;
+
+        sprintf((char*)_mac_buffer,"%02X:%02X:%02X:%02X:%02X:%02X", n1, n2, n3, n4, n5, n6);
+        _cache_update(SPWFSA_CACHE_MAC);
+    }
     return _mac_buffer;
 }
 
@@ -529,9 +1090,22 @@ bool SPWFSAxx::isConnected(void)
 
 nsapi_size_or_error_t SPWFSAxx::send(int spwf_id, const void *data, uint32_t amount, int internal_id)
 {
-    uint32_t sent = 0U, to_send;
+    struct chunk chunk = { (char*)data, amount };
+
+    return sendv(spwf_id, &chunk, 1, internal_id);
+}
+
+nsapi_size_or_error_t SPWFSAxx::sendv(int spwf_id, const struct chunk *chunks, unsigned int count, int internal_id)
+{
+    uint32_t amount = 0U, sent = 0U, to_send;
+    uint32_t chunk_offset = 0U;
+    unsigned int chunk_idx = 0;
     nsapi_size_or_error_t ret;
 
+    for(unsigned int i = 0; i < count; i++) {
+        amount += chunks[i].len;
+    }
+
     BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
                                  Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
 
@@ -548,16 +1122,20 @@ nsapi_size_or_error_t SPWFSAxx::send(int spwf_id, const void *data, uint32_t amo
             if (!_associated_interface._socket_is_still_connected(internal_id)) {
                 debug_if(_dbg_on, "\r\nSPWF> Socket not connected anymore: sent=%u, to_send=%u! (%s, %d)\r\n", sent, to_send, __func__, __LINE__);
                 break;
-            } else if(!_parser.send("AT+S.SOCKW=%d,%d", spwf_id, (unsigned int)to_send)) {
+            } else if(!_send_cmd("AT+S.SOCKW=%d,%d", spwf_id, (unsigned int)to_send)) {
                 debug_if(_dbg_on, "\r\nSPWF> Sending command failed: sent=%u, to_send=%u! (%s, %d)\r\n", sent, to_send, __func__, __LINE__);
                 break;
-            } else if(_parser.write(((char*)data)+sent, (int)to_send) != (int)to_send) {
+            } else if(!_write_out_chunks(chunks, count, &chunk_idx, &chunk_offset, to_send)) { // one SOCKW may cover several chunks
                 debug_if(_dbg_on, "\r\nSPWF> Sending data failed: sent=%u, to_send=%u! (%s, %d)\r\n", sent, to_send, __func__, __LINE__);
                 break;
             } else if(!_recv_ok()) {
                 debug_if(_dbg_on, "\r\nSPWF> Sending did not receive OK: sent=%u, to_send=%u! (%s, %d)\r\n", sent, to_send, __func__, __LINE__);
                 break;
             }
+
+#if SPWFSA_TRACE_SIZE > 0
+            _trace(SPWFSA_TRACE_SEND, spwf_id, to_send, sent);
+#endif // SPWFSA_TRACE_SIZE > 0
         }
 
         sent += to_send;
@@ -579,7 +1157,9 @@ nsapi_size_or_error_t SPWFSAxx::send(int spwf_id, const void *data, uint32_t amo
 int SPWFSAxx::_read_len(int spwf_id) {
     unsigned int amount;
 
-    if (!(_parser.send("AT+S.SOCKQ=%d", spwf_id)
+    _rx_at_cmd_cnt++;
+
+    if (!(_send_cmd("AT+S.SOCKQ=%d", spwf_id)
             && _parser.recv(SPWFXX_RECV_DATALEN, &amount)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> %s failed\r\n", __func__);
@@ -587,7 +1167,8 @@ int SPWFSAxx::_read_len(int spwf_id) {
     }
 
     if(amount > 0) {
-        debug_if(_dbg_on, "\r\nSPWF> %s():\t\t%d:%d\r\n", __func__, spwf_id, amount);
+        SPWFXX_TRACE(SPWFSA_TRACE_READ_LEN, spwf_id, amount, 0,
+                     "\r\nSPWF> %s():\t\t%d:%d\r\n", __func__, spwf_id, amount);
     }
 
     MBED_ASSERT(((int)amount) >= 0);
@@ -597,27 +1178,127 @@ int SPWFSAxx::_read_len(int spwf_id) {
 
 #define SPWFXX_WINDS_OFF "0xFFFFFFFF"
 
+/* Note: asynchronous indications get switched on again only by the outermost call of nested
+ *       `_winds_off()`/`_winds_on()` pairs, i.e. at the end of a burst of module operations
+ * Note: as the module drops WINDs while they are switched off, pending data gets queried afterwards
+ */
 void SPWFSAxx::_winds_on(void) {
+    bool resync = _winds_held;
+
     MBED_ASSERT(_is_event_callback_blocked());
 
-    if(!(_parser.send(SPWFXX_SEND_WIND_OFF_HIGH SPWFXX_WINDS_HIGH_ON) && _recv_ok())) {
-        debug_if(_dbg_on, "\r\nSPWF> %s failed at line #%d\r\n", __func__, __LINE__);
+    if(_winds_off_cnt > 0) {
+        if(--_winds_off_cnt > 0) return; // still within an outer burst
+        resync = true;
     }
-    if(!(_parser.send(SPWFXX_SEND_WIND_OFF_MEDIUM SPWFXX_WINDS_MEDIUM_ON) && _recv_ok())) {
+    _winds_held = false;
+
+    _rx_at_cmd_cnt += 3;
+#if SPWFSA_TRACE_SIZE > 0
+    _trace(SPWFSA_TRACE_WINDS_ON, -1, 0, 0);
+#endif // SPWFSA_TRACE_SIZE > 0
+
+    if(!(_send_cmd(SPWFXX_SEND_WIND_OFF_HIGH SPWFXX_WINDS_HIGH_ON) && _recv_ok())) {
+        debug_if(_dbg_on, "\r\nSPWF> %s failed at line #%d\r\n", __func__, __LINE__);
+    }
+    if(!(_send_cmd(SPWFXX_SEND_WIND_OFF_MEDIUM SPWFXX_WINDS_MEDIUM_ON) && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> %s failed at line #%d\r\n", __func__, __LINE__);
     }
-    if(!(_parser.send(SPWFXX_SEND_WIND_OFF_LOW SPWFXX_WINDS_LOW_ON) && _recv_ok())) {
+    if(!(_send_cmd(SPWFXX_SEND_WIND_OFF_LOW SPWFXX_WINDS_LOW_ON) && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> %s failed at line #%d\r\n", __func__, __LINE__);
     }
+
+    if(resync) {
+        _winds_resync();
+    }
+}
+
+/* Query pending data of all connected sockets, as "+WIND:55" gets dropped while WINDs are switched off
+ * (a dropped "+WIND:58" resp. "+WIND:33" shows up as `SOCKQ` failure,
+ *  the socket gets marked as closed by the peer & signaled then) */
+void SPWFSAxx::_winds_resync(void) {
+    for(int internal_id = 0; internal_id < SPWFSA_SOCKET_COUNT; internal_id++) {
+        if(!_associated_interface._socket_has_connected(internal_id)) continue;
+
+        int spwf_id = _associated_interface._ids[internal_id].spwf_id;
+        int amount = _read_len(spwf_id); // triggers also async indication handling!
+
+        if(amount < 0) { // closed by the peer while WINDs were switched off
+            _associated_interface._ids[internal_id].server_gone = true;
+            _call_callback();
+        } else if((uint32_t)amount > _get_cumulative_size(spwf_id)) {
+            _add_pending_packet_sz(spwf_id, (uint32_t)amount);
+        }
+    }
+}
+
+/* End a burst like `_winds_on()`, but keep asynchronous indications switched off for
+ * `SPWF_WINDS_HOLD_TIME` ms, so that the application's following reads do not have to switch them off again
+ * Note: WINDs get switched on again by the driver worker thread, resp. as soon as
+ *       `recv()` runs out of data or an operation depending on WINDs is started (see `_winds_restore()`)
+ * Note: without RTOS (resp. driver worker thread) this is equal to `_winds_on()`
+ */
+void SPWFSAxx::_winds_hold(void) {
+#if MBED_CONF_RTOS_PRESENT
+    if((_winds_off_cnt == 1) && _associated_interface._worker_thread_started) {
+        _winds_off_cnt = 0;
+        _winds_hold_stamp = _ticker_us();
+        if(!_winds_held) {
+            _winds_held = true;
+            _associated_interface._worker_sem.release(); // let worker thread switch WINDs on again in time
+        }
+        return;
+    }
+#endif // MBED_CONF_RTOS_PRESENT
+
+    _winds_on();
+}
+
+/* switch asynchronous indications on again if they are just held (i.e. outside of any burst) */
+void SPWFSAxx::_winds_restore(void) {
+    if(!_winds_held || (_winds_off_cnt > 0)) return;
+
+    BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
+                                 Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
+
+    _winds_on();
 }
 
+#if MBED_CONF_RTOS_PRESENT
+/* Note: to be called by the driver worker thread (with driver lock held),
+ *       returns time (in ms) until held WINDs have to be switched on again */
+uint32_t SPWFSAxx::_winds_check_hold(void) {
+    if(!_winds_held) return osWaitForever;
+
+    uint32_t held_ms = (uint32_t)((_ticker_us() - _winds_hold_stamp) / 1000);
+    if(held_ms < SPWF_WINDS_HOLD_TIME) return (SPWF_WINDS_HOLD_TIME - held_ms);
+
+    _winds_restore();
+    return osWaitForever;
+}
+#endif // MBED_CONF_RTOS_PRESENT
+
 /* Define beyond macro in case you want to report back failures in switching off WINDs to the caller */
 // #define SPWFXX_SOWF
 /* Note: in case of error blocking has been (tried to be) lifted */
+/* Note: asynchronous indications get switched off only by the outermost call of nested
+ *       `_winds_off()`/`_winds_on()` pairs
+ */
 bool SPWFSAxx::_winds_off(void) {
     MBED_ASSERT(_is_event_callback_blocked());
 
-    if (!(_parser.send(SPWFXX_SEND_WIND_OFF_LOW SPWFXX_WINDS_OFF)
+    if(_winds_off_cnt++ > 0) return true; // already switched off by an outer burst
+    if(_winds_held) { // still switched off since last read, burst takes over
+        _winds_held = false;
+        return true;
+    }
+
+    _rx_at_cmd_cnt += 3;
+#if SPWFSA_TRACE_SIZE > 0
+    _trace(SPWFSA_TRACE_WINDS_OFF, -1, 0, 0);
+#endif // SPWFSA_TRACE_SIZE > 0
+
+    if (!(_send_cmd(SPWFXX_SEND_WIND_OFF_LOW SPWFXX_WINDS_OFF)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> %s failed at line #%d\r\n", __func__, __LINE__);
 #ifdef SPWFXX_SOWF // betzw: try to continue
@@ -626,7 +1307,7 @@ bool SPWFSAxx::_winds_off(void) {
 #endif
     }
 
-    if (!(_parser.send(SPWFXX_SEND_WIND_OFF_MEDIUM SPWFXX_WINDS_OFF)
+    if (!(_send_cmd(SPWFXX_SEND_WIND_OFF_MEDIUM SPWFXX_WINDS_OFF)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> %s failed at line #%d\r\n", __func__, __LINE__);
 #ifdef SPWFXX_SOWF // betzw: try to continue
@@ -635,7 +1316,7 @@ bool SPWFSAxx::_winds_off(void) {
 #endif
     }
 
-    if (!(_parser.send(SPWFXX_SEND_WIND_OFF_HIGH SPWFXX_WINDS_OFF)
+    if (!(_send_cmd(SPWFXX_SEND_WIND_OFF_HIGH SPWFXX_WINDS_OFF)
             && _recv_ok())) {
         debug_if(_dbg_on, "\r\nSPWF> %s failed at line #%d\r\n", __func__, __LINE__);
 #ifdef SPWFXX_SOWF // betzw: try to continue
@@ -655,6 +1336,15 @@ void SPWFSAxx::_execute_bottom_halves(void) {
 void SPWFSAxx::_read_in_pending(void) {
     static int internal_id_cnt = 0;
 
+    if(!_is_data_pending()) return;
+
+    BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
+                                 Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* do not call (external) callback in IRQ context while receiving */
+
+    /* block asynchronous indications only once for the whole burst of reads */
+    if(!_winds_off()) return;
+    BlockExecuter winds_enabler(Callback<void()>(this, &SPWFSAxx::_winds_on));
+
     while(_is_data_pending()) {
         if(_associated_interface._socket_has_connected(internal_id_cnt)) {
             int spwf_id = _associated_interface._ids[internal_id_cnt].spwf_id;
@@ -663,7 +1353,7 @@ void SPWFSAxx::_read_in_pending(void) {
                 int amount;
 
                 amount = _read_in_pkt(spwf_id, false);
-                if(amount == SPWFXX_ERR_OOM) { /* consider only 'SPWFXX_ERR_OOM' as non recoverable */
+                if(amount == SPWFXX_ERR_OOM) { /* packet pool exhausted: continue once user has consumed some packets */
                     return;
                 }
             }
@@ -681,37 +1371,85 @@ void SPWFSAxx::_read_in_pending(void) {
 
 /* Note: returns
  * 'SPWFXX_ERR_OK'   in case of success
- * 'SPWFXX_ERR_OOM'  in case of "out of memory"
+ * 'SPWFXX_ERR_OOM'  in case of exhausted packet pool
  * 'SPWFXX_ERR_READ' in case of `_read_in()` error
+ *
+ * Note: reads in the next `count` pending packets (of overall `amount` bytes)
+ * Note: if `buffer` is not NULL data is read directly into it (i.e. not queued)
  */
-int SPWFSAxx::_read_in_packet(int spwf_id, uint32_t amount) {
-    struct packet *packet = (struct packet*)malloc(sizeof(struct packet) + amount);
-    if (!packet) {
-#ifndef NDEBUG
-        error("\r\nSPWF> %s(%d): Out of memory!\r\n", __func__, __LINE__);
-#else // NDEBUG
-        debug("\r\nSPWF> %s(%d): Out of memory!\r\n", __func__, __LINE__);
-#endif
-        debug_if(_dbg_on, "\r\nSPWF> %s failed (%d)\r\n", __func__, __LINE__);
-        return SPWFXX_ERR_OOM; /* out of memory: give up here! */
+int SPWFSAxx::_read_in_packet(int spwf_id, unsigned int count, uint32_t amount, char *buffer) {
+    struct packet *packets[PENDING_DATA_SLOTS];
+    struct chunk chunks[PENDING_DATA_SLOTS];
+    unsigned int i;
+
+    MBED_ASSERT((count > 0) && (count < PENDING_DATA_SLOTS));
+
+    if(buffer != NULL) { /* read data in directly */
+        chunks[0].buffer = buffer;
+        chunks[0].len = amount;
+
+        if(!(_read_in(chunks, 1, spwf_id, amount) > 0)) {
+            debug_if(_dbg_on, "\r\nSPWF> %s failed (%d)\r\n", __func__, __LINE__);
+            return SPWFXX_ERR_READ;
+        }
+
+        SPWFXX_TRACE(SPWFSA_TRACE_READ_DIRECT, spwf_id, amount, 0,
+                     "\r\nSPWF> %s():\t%d:%d (direct)\r\n", __func__, spwf_id, amount);
+        _rx_bytes_cnt += amount;
+        return SPWFXX_ERR_OK;
+    }
+
+    /* allocate & init one packet per pending packet size */
+    {
+        PKT_SYNC_HANDLER;
+
+        for(i = 0; i < count; i++) {
+            uint32_t len = _get_pending_pkt_size(spwf_id, i);
+
+            MBED_ASSERT((len > 0) && (len <= SPWFXX_SEND_RECV_PKTSIZE));
+
+            packets[i] = (struct packet*)_packet_pool.alloc();
+            if (!packets[i]) {
+                /* pool exhausted: leave data on module until user has consumed some packets */
+                debug_if(_dbg_on, "\r\nSPWF> %s(%d): Packet pool exhausted!\r\n", __func__, __LINE__);
+                while(i > 0) {
+                    _packet_pool.free(packets[--i]);
+                }
+                _packet_pool_oom = true;
+                return SPWFXX_ERR_OOM;
+            }
+
+            packets[i]->id = spwf_id;
+            packets[i]->len = len;
+            packets[i]->offset = 0;
+
+            chunks[i].buffer = (char*)(packets[i] + 1);
+            chunks[i].len = len;
+        }
     }
 
-    /* init packet */
-    packet->id = spwf_id;
-    packet->len = amount;
-    packet->next = 0;
+    /* read data in (packets are not yet visible to `recvQueued()`) */
+    if(!(_read_in(chunks, count, spwf_id, amount) > 0)) {
+        PKT_SYNC_HANDLER;
 
-    /* read data in */
-    if(!(_read_in((char*)(packet + 1), spwf_id, amount) > 0)) {
-        free(packet);
+        for(i = 0; i < count; i++) {
+            _packet_pool.free(packets[i]);
+        }
         debug_if(_dbg_on, "\r\nSPWF> %s failed (%d)\r\n", __func__, __LINE__);
         return SPWFXX_ERR_READ;
     } else {
-        debug_if(_dbg_on, "\r\nSPWF> %s():\t%d:%d\r\n", __func__, spwf_id, amount);
+        SPWFXX_TRACE(SPWFSA_TRACE_READ_QUEUED, spwf_id, amount, count,
+                     "\r\nSPWF> %s():\t%d:%d (%u packets)\r\n", __func__, spwf_id, amount, count);
+        _rx_bytes_cnt += amount;
 
-        /* append to packet list */
-        *_packets_end = packet;
-        _packets_end = &packet->next;
+        /* append to packet queue of socket */
+        {
+            PKT_SYNC_HANDLER;
+
+            for(i = 0; i < count; i++) {
+                _enqueue_packet(packets[i]);
+            }
+        }
 
         /* force call of (external) callback */
         _call_callback();
@@ -721,19 +1459,38 @@ int SPWFSAxx::_read_in_packet(int spwf_id, uint32_t amount) {
 }
 
 void SPWFSAxx::_free_packets(int spwf_id) {
-    // check if any packets are ready for `spwf_id`
-    for(struct packet **p = &_packets; *p;) {
-        if ((*p)->id == spwf_id) {
-            struct packet *q = *p;
-            if (_packets_end == &(*p)->next) {
-                _packets_end = p;
-            }
-            *p = (*p)->next;
-            free(q);
-        } else {
-            p = &(*p)->next;
+    struct packet *p;
+    bool relieved = false;
+
+    {
+        PKT_SYNC_HANDLER;
+
+        // free all packets queued for `spwf_id`
+        while((p = _dequeue_packet(spwf_id)) != 0) {
+            relieved |= _release_packet(p);
         }
     }
+
+    if(relieved) {
+        _packet_pool_relieved();
+    }
+}
+
+/* Packet pool had been exhausted and a slot has been freed again (called w/o packet lock held):
+ * data left on the module (possibly for other sockets) can be read in now */
+void SPWFSAxx::_packet_pool_relieved(void) {
+    debug_if(_dbg_on, "\r\nSPWF> %s()\r\n", __func__);
+#if SPWFSA_EVENT_THREAD
+    /* let driver event thread read in pending data & call (external) callback */
+    if(_associated_interface._worker_thread_started) {
+        core_util_atomic_incr_u32(&_irq_events, 1); // races with `_event_handler()`
+        _associated_interface._worker_sem.release();
+        return;
+    }
+#endif // SPWFSA_EVENT_THREAD
+
+    /* make sockets retry their receives */
+    _call_callback();
 }
 
 void SPWFSAxx::_free_all_packets() {
@@ -751,36 +1508,48 @@ bool SPWFSAxx::close(int spwf_id)
 
     MBED_ASSERT(((unsigned int)spwf_id) < ((unsigned int)SPWFSA_SOCKET_COUNT)); // `spwf_id` is valid
 
+    _close_stamps[spwf_id] = _ticker_us();
+
     for(int retry_cnt = 0; retry_cnt < SPWFXX_MAX_TRIALS; retry_cnt++) {
         Timer timer;
         timer.start();
 
-        // Flush out pending data
-        while(true) {
-            int amount = _read_in_pkt(spwf_id, true);
-            if(amount < 0) { // SPWFXX error
-                /* empty RX buffer & try to close */
-                empty_rx_buffer();
-                break;
-            }
-            if(amount == 0) break; // no more data to be read
+        // Flush out pending data (with asynchronous indications blocked for the whole flush)
+        if(_winds_off()) {
+            BlockExecuter winds_enabler(Callback<void()>(this, &SPWFSAxx::_winds_on));
 
-            /* Try to work around module API bug:
-             * break out & try to close after 20 seconds
-             */
-            if(timer.read() > 20) {
-                break;
-            }
+            while(true) {
+                int amount = _read_in_pkt(spwf_id, true);
+                if(amount == SPWFXX_ERR_OOM) { // packet pool exhausted (by other sockets)
+                    /* try to close (module discards pending data) */
+                    break;
+                }
+                if(amount < 0) { // SPWFXX error
+                    /* empty RX buffer & try to close */
+                    empty_rx_buffer();
+                    break;
+                }
+                if(amount == 0) break; // no more data to be read
 
-            /* immediately free packet(s) (to avoid "out of memory") */
-            _free_packets(spwf_id);
+                _close_stats.drain_bytes += amount;
 
-            /* interleave bottom halves */
-            _execute_bottom_halves();
+                /* Try to work around module API bug:
+                 * break out & try to close after 20 seconds
+                 */
+                if(timer.read() > 20) {
+                    break;
+                }
+
+                /* immediately free packet(s) (to avoid "out of memory") */
+                _free_packets(spwf_id);
+
+                /* interleave packet bottom half (network loss handling requires WINDs to be on) */
+                _packet_handler_bh();
+            }
         }
 
         // Close socket
-        if (_parser.send("AT+S.SOCKC=%d", spwf_id)
+        if (_send_cmd("AT+S.SOCKC=%d", spwf_id)
                 && _recv_ok()) {
             ret = true;
             break; // finish closing
@@ -798,35 +1567,116 @@ bool SPWFSAxx::close(int spwf_id)
     _execute_bottom_halves();
 
     if(ret) {
-        /* clear pending data flag (should be redundant) */
-        _clear_pending_data(spwf_id);
-
-        /* free packets for this socket */
-        _free_packets(spwf_id);
-
-        /* reset pending data sizes */
-        _reset_pending_pkt_sizes(spwf_id);
+        _close_cleanup(spwf_id);
+        _close_completed(spwf_id, false);
     } else {
         debug_if(_dbg_on, "\r\nSPWF> SPWFSAxx::close failed (%d)\r\n", __LINE__);
 
         int internal_id = _associated_interface.get_internal_id(spwf_id);
         if(!_associated_interface._socket_is_still_connected(internal_id)) {
-            /* clear pending data flag (should be redundant) */
-            _clear_pending_data(spwf_id);
-
-            /* free packets for this socket */
-            _free_packets(spwf_id);
-
-            /* reset pending data sizes */
-            _reset_pending_pkt_sizes(spwf_id);
+            _close_cleanup(spwf_id);
 
             ret = true;
         }
+        _close_stats.failed++;
     }
 
     return ret;
 }
 
+void SPWFSAxx::closeDeferred(int spwf_id)
+{
+    MBED_ASSERT(((unsigned int)spwf_id) < ((unsigned int)SPWFSA_SOCKET_COUNT)); // `spwf_id` is valid
+
+    /* data already received is of no interest anymore
+     * (Note: pending data bit MUST NOT remain set for a socket without `internal_id`) */
+    _close_cleanup(spwf_id);
+
+    _close_stamps[spwf_id] = _ticker_us();
+    _close_trials[spwf_id] = 0;
+    _closing_sockets_bitmap |= (1 << spwf_id);
+}
+
+bool SPWFSAxx::processDeferredCloses(void)
+{
+    if(_closing_sockets_bitmap == 0) return false;
+
+    BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
+                                 Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* disable calling (external) callback in IRQ context */
+
+    for(int spwf_id = 0; spwf_id < SPWFSA_SOCKET_COUNT; spwf_id++) {
+        if(!(_closing_sockets_bitmap & (1 << spwf_id))) continue;
+
+        /* Try to work around module API bug: try to close after 20 seconds of draining */
+        if((_ticker_us() - _close_stamps[spwf_id]) <= 20000000ULL) {
+            int amount = 0;
+
+            // Drain (at most) one chunk of pending data
+            if(_winds_off()) {
+                BlockExecuter winds_enabler(Callback<void()>(this, &SPWFSAxx::_winds_on));
+
+                amount = _read_in_pkt(spwf_id, true);
+                if((amount < 0) && (amount != SPWFXX_ERR_OOM)) { // SPWFXX error
+                    /* empty RX buffer & try to close */
+                    empty_rx_buffer();
+                }
+            }
+
+            /* discard drained data */
+            _close_cleanup(spwf_id);
+
+            if(amount > 0) {
+                _close_stats.drain_bytes += amount;
+                continue; // drain on with next step
+            }
+        }
+
+        // Close socket
+        if (_send_cmd("AT+S.SOCKC=%d", spwf_id)
+                && _recv_ok()) {
+            _closing_sockets_bitmap &= ~(1 << spwf_id);
+            _close_cleanup(spwf_id);
+            _close_completed(spwf_id, true);
+        } else { // close failed
+            debug_if(_dbg_on, "\r\nSPWF> %s failed (%d)\r\n", __func__, __LINE__);
+
+            if(++_close_trials[spwf_id] >= SPWFXX_MAX_TRIALS) { // give up
+                _closing_sockets_bitmap &= ~(1 << spwf_id);
+                _close_cleanup(spwf_id);
+                _close_stats.failed++;
+            }
+        }
+    }
+
+    /* anticipate bottom halves */
+    _execute_bottom_halves();
+
+    return (_closing_sockets_bitmap != 0);
+}
+
+/* drop all (pending) data of socket `spwf_id` */
+void SPWFSAxx::_close_cleanup(int spwf_id)
+{
+    /* clear pending data flag */
+    _clear_pending_data(spwf_id);
+
+    /* free packets for this socket */
+    _free_packets(spwf_id);
+
+    /* reset pending data sizes */
+    _reset_pending_pkt_sizes(spwf_id);
+}
+
+void SPWFSAxx::_close_completed(int spwf_id, bool deferred)
+{
+    uint32_t latency = (uint32_t)((_ticker_us() - _close_stamps[spwf_id]) / 1000);
+
+    _close_stats.closed++;
+    if(deferred) _close_stats.deferred++;
+    _close_stats.last_latency_ms = latency;
+    if(latency > _close_stats.max_latency_ms) _close_stats.max_latency_ms = latency;
+}
+
 /*
  * Buffered serial event handler
  *
@@ -835,6 +1685,16 @@ bool SPWFSAxx::close(int spwf_id)
  */
 void SPWFSAxx::_event_handler(void)
 {
+#if SPWFSA_EVENT_THREAD
+    /* hand over to driver event thread, which calls (external) callback from thread context */
+    if(_associated_interface._worker_thread_started) {
+        core_util_atomic_incr_u32(&_irq_events, 1);
+        _associated_interface._worker_sem.release();
+        return;
+    }
+#endif // SPWFSA_EVENT_THREAD
+
+    /* no event thread (running): call (external) callback from IRQ context */
     if(!_is_event_callback_blocked()) {
         _call_callback();
     }
@@ -845,11 +1705,7 @@ void SPWFSAxx::_event_handler(void)
  */
 void SPWFSAxx::_error_handler(void)
 {
-    if(_parser.recv("%255[^\n]\n", _msg_buffer) && _recv_delim_lf()) {
-        debug_if(_dbg_on, "AT^ ERROR:%s (%d)\r\n", _msg_buffer, __LINE__);
-    } else {
-        debug_if(_dbg_on, "\r\nSPWF> Unknown ERROR string in SPWFSAxx::_error_handler (%d)\r\n", __LINE__);
-    }
+    debug_if(_dbg_on, "AT^ ERROR:%s (%d)\r\n", _engine.text(), __LINE__);
 
     /* force call of (external) callback */
     _call_callback();
@@ -858,15 +1714,13 @@ void SPWFSAxx::_error_handler(void)
 /*
  * Handling oob ("+WIND:33:WiFi Network Lost")
  */
-void SPWFSAxx::_network_lost_handler_th(void)
+void SPWFSAxx::_network_lost_handler_th(const char *args)
 {
 #ifndef NDEBUG
     static unsigned int net_loss_cnt = 0;
     net_loss_cnt++;
 #endif
 
-    _recv_delim_cr_lf();
-
     debug_if(_dbg_on, "AT^ +WIND:33:WiFi Network Lost\r\n");
 
 #ifndef NDEBUG
@@ -875,8 +1729,18 @@ void SPWFSAxx::_network_lost_handler_th(void)
     debug_if(_dbg_on, "\r\nSPWF> Getting out of SPWFSAxx::_network_lost_handler_th: %d\r\n", __LINE__);
 #endif // NDEBUG
 
-    /* set flag to signal network loss */
-    _network_lost_flag = true;
+    _cache_invalidate_net();
+
+    /* start recovery, i.e. wait (in the background) for the module to re-associate */
+    if(isConnected()) {
+        _associated_interface._connected_to_network = false; // make socket calls fail fast
+        _network_lost_flag = true;
+
+        _assoc_state = SPWFSA_ASSOC_ONGOING;
+        _assoc_deauths = 0;
+        _connect_timer.reset();
+        _connect_timer.start();
+    }
 
     /* force call of (external) callback */
     _call_callback();
@@ -897,7 +1761,7 @@ void SPWFSAxx::_add_pending_packet_sz(int spwf_id, uint32_t size) {
     for(to_add = ((size - added) > SPWFXX_SEND_RECV_PKTSIZE) ? SPWFXX_SEND_RECV_PKTSIZE : (size - added);
             added < size;
             to_add = ((size - added) > SPWFXX_SEND_RECV_PKTSIZE) ? SPWFXX_SEND_RECV_PKTSIZE : (size - added)) {
-        _add_pending_pkt_size(spwf_id, added + to_add);
+        if(!_add_pending_pkt_size(spwf_id, added + to_add)) break; // no free slot, rest gets queried later
         added += to_add;
     }
 
@@ -911,21 +1775,19 @@ void SPWFSAxx::_add_pending_packet_sz(int spwf_id, uint32_t size) {
 /*
  * Handling oob ("+WIND:55:Pending Data")
  */
-void SPWFSAxx::_packet_handler_th(void)
+void SPWFSAxx::_packet_handler_th(const char *args)
 {
     int internal_id, spwf_id;
     int amount;
 
     /* parse out the socket id & amount */
-    if (!(_parser.recv(SPWFXX_RECV_PENDING_DATA, &spwf_id, &amount) && _recv_delim_lf())) {
+    if (sscanf(args, SPWFXX_RECV_PENDING_DATA, &spwf_id, &amount) != 2) {
 #ifndef NDEBUG
         error("\r\nSPWF> SPWFSAxx::%s failed!\r\n", __func__);
 #endif
         return;
     }
 
-    debug_if(_dbg_on, "AT^ +WIND:55:Pending Data:%d:%d\r\n", spwf_id, amount);
-
     /* check for the module to report a valid id */
     MBED_ASSERT(((unsigned int)spwf_id) < ((unsigned int)SPWFSA_SOCKET_COUNT));
 
@@ -934,8 +1796,9 @@ void SPWFSAxx::_packet_handler_th(void)
      *       therefore we just record the socket id without considering the `amount` of data reported!
      */
     internal_id = _associated_interface.get_internal_id(spwf_id);
+    SPWFXX_TRACE(SPWFSA_TRACE_PENDING_DATA, spwf_id, amount, (internal_id != SPWFSA_SOCKET_COUNT),
+                 "AT^ +WIND:55:Pending Data:%d:%d\r\n", spwf_id, amount);
     if(internal_id != SPWFSA_SOCKET_COUNT) {
-        debug_if(_dbg_on, "AT^ +WIND:55:Pending Data:%d:%d - #2\r\n", spwf_id, amount);
         _add_pending_packet_sz(spwf_id, amount);
 
         MBED_ASSERT(_get_pending_pkt_size(spwf_id) != 0);
@@ -944,55 +1807,35 @@ void SPWFSAxx::_packet_handler_th(void)
     }
 }
 
+/* Non-blocking step of network loss recovery (see `_network_lost_handler_th()`) */
 void SPWFSAxx::_network_lost_handler_bh(void)
 {
     if(!_network_lost_flag) return;
-    _network_lost_flag = false;
-
-    {
-        bool were_connected;
-        BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
-                                     Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* do not call (external) callback in IRQ context as long as network is lost */
-        Timer timer;
-        timer.start();
-
-        _parser.set_timeout(SPWF_NETLOST_TIMEOUT);
-
-        were_connected = isConnected();
-        _associated_interface._connected_to_network = false;
-
-        if(were_connected) {
-            unsigned int n1, n2, n3, n4;
-
-            while(true) {
-                if (timer.read_ms() > SPWF_CONNECT_TIMEOUT) {
-                    debug_if(_dbg_on, "\r\nSPWF> SPWFSAxx::_network_lost_handler_bh() #%d\r\n", __LINE__);
-                    disconnect();
-                    empty_rx_buffer();
-                    goto nlh_get_out;
-                }
-
-                if((_parser.recv(SPWFXX_RECV_WIFI_UP, &n1, &n2, &n3, &n4)) && _recv_delim_lf()) {
-                    debug_if(_dbg_on, "\r\nSPWF> Re-connected (%u.%u.%u.%u)!\r\n", n1, n2, n3, n4);
 
-                    _associated_interface._connected_to_network = true;
-                    goto nlh_get_out;
-                }
+    switch(pollAssociation()) {
+        case SPWFSA_ASSOC_UP:
+            debug_if(_dbg_on, "\r\nSPWF> Re-connected (%s)!\r\n", _ip_buffer);
+            _network_lost_flag = false;
+            _associated_interface._connected_to_network = true;
+            break;
+        case SPWFSA_ASSOC_ONGOING:
+        case SPWFSA_ASSOC_LINK_UP:
+            if(_connect_timer.read_ms() <= SPWF_CONNECT_TIMEOUT) {
+                return; // still waiting
             }
-        } else {
-            debug_if(_dbg_on, "\r\nSPWF> Leaving SPWFSAxx::_network_lost_handler_bh\r\n");
-            goto nlh_get_out;
-        }
-
-    nlh_get_out:
-        debug_if(_dbg_on, "\r\nSPWF> Getting out of SPWFSAxx::_network_lost_handler_bh\r\n");
-        _parser.set_timeout(_timeout);
+            debug_if(_dbg_on, "\r\nSPWF> SPWFSAxx::_network_lost_handler_bh() #%d\r\n", __LINE__);
+            disconnect();
+            empty_rx_buffer();
+            break;
+        default: // too many deauthentications or disconnected meanwhile
+            _network_lost_flag = false;
+            break;
+    }
 
-        /* force call of (external) callback */
-        _call_callback();
+    debug_if(_dbg_on, "\r\nSPWF> Getting out of SPWFSAxx::_network_lost_handler_bh\r\n");
 
-        return;
-    }
+    /* force call of (external) callback */
+    _call_callback();
 }
 
 void SPWFSAxx::_recover_from_hard_faults(void) {
@@ -1006,22 +1849,13 @@ void SPWFSAxx::_recover_from_hard_faults(void) {
 /*
  * Handling oob ("+WIND:8:Hard Fault")
  */
-void SPWFSAxx::_hard_fault_handler(void)
+void SPWFSAxx::_hard_fault_handler(const char *args)
 {
-    _parser.set_timeout(SPWF_RECV_TIMEOUT);
-    if(_parser.recv("%255[^\n]\n", _msg_buffer) && _recv_delim_lf()) {
 #ifndef NDEBUG
-        error("\r\nSPWF> hard fault error:\r\n%s\r\n", _msg_buffer);
+    error("\r\nSPWF> hard fault error:\r\n%s\r\n", args);
 #else // NDEBUG
-        debug("\r\nSPWF> hard fault error:\r\n%s\r\n", _msg_buffer);
+    debug("\r\nSPWF> hard fault error:\r\n%s\r\n", args);
 #endif // NDEBUG
-    } else {
-#ifndef NDEBUG
-        error("\r\nSPWF> unknown hard fault error\r\n");
-#else // NDEBUG
-        debug("\r\nSPWF> unknown hard fault error\r\n");
-#endif // NDEBUG
-    }
 
     // This is most likely the best we can do to recover from this module hard fault
     _parser.set_timeout(SPWF_HF_TIMEOUT);
@@ -1035,13 +1869,12 @@ void SPWFSAxx::_hard_fault_handler(void)
 /*
  * Handling oob ("+WIND:5:WiFi Hardware Failure")
  */
-void SPWFSAxx::_wifi_hwfault_handler(void)
+void SPWFSAxx::_wifi_hwfault_handler(const char *args)
 {
-    unsigned int failure_nr;
+    unsigned int failure_nr = 0;
 
-    /* parse out the socket id & amount */
-    _parser.recv(":%u\n", &failure_nr);
-    _recv_delim_lf();
+    /* parse out the failure number */
+    sscanf(args, ":%u", &failure_nr);
 
 #ifndef NDEBUG
     error("\r\nSPWF> WiFi HW fault error: %u\r\n", failure_nr);
@@ -1065,18 +1898,19 @@ void SPWFSAxx::_wifi_hwfault_handler(void)
  * NOTE: When a socket client receives an indication about socket server gone (only for TCP sockets, WIND:58),
  *       the socket connection is NOT automatically closed!
  */
-void SPWFSAxx::_server_gone_handler(void)
+void SPWFSAxx::_server_gone_handler(const char *args)
 {
     int spwf_id, internal_id;
 
-    if(!(_parser.recv(SPWFXX_RECV_SOCKET_CLOSED, &spwf_id) && _recv_delim_lf())) {
+    if(sscanf(args, SPWFXX_RECV_SOCKET_CLOSED, &spwf_id) != 1) {
 #ifndef NDEBUG
         error("\r\nSPWF> SPWFSAxx::%s failed!\r\n", __func__);
 #endif
         goto _get_out;
     }
 
-    debug_if(_dbg_on, "AT^ +WIND:58:Socket Closed:%d\r\n", spwf_id);
+    SPWFXX_TRACE(SPWFSA_TRACE_SOCK_CLOSED, spwf_id, 0, 0,
+                 "AT^ +WIND:58:Socket Closed:%d\r\n", spwf_id);
 
     /* check for the module to report a valid id */
     MBED_ASSERT(((unsigned int)spwf_id) < ((unsigned int)SPWFSA_SOCKET_COUNT));
@@ -1094,19 +1928,54 @@ _get_out:
     _call_callback();
 }
 
-#if MBED_CONF_IDW0XX1_EXPANSION_BOARD == IDW04A1
+/* parse IPv4 address out of a "+WIND:24:WiFi Up" line into IP address cache */
+bool SPWFSAxx::_update_ip_from_wifi_up(const char *line)
+{
+    unsigned int n1, n2, n3, n4;
+
+    if(sscanf(line, SPWFXX_RECV_WIFI_UP, &n1, &n2, &n3, &n4) != 4) {
+        return false;
+    }
+
+    {
+        CACHE_SYNC_HANDLER;
+
+        sprintf((char*)_ip_buffer,"%u.%u.%u.%u", n1, n2, n3, n4);
+        _cache_update(SPWFSA_CACHE_IP);
+    }
+    return true;
+}
+
 /*
- * Handling oob (currently only for "+WIND:24:WiFi Up::")
+ * Handling oob ("+WIND:24:WiFi Up")
  */
-void SPWFSAxx::_skip_oob(void)
+void SPWFSAxx::_wifi_up_handler(const char *args)
 {
-    if(_parser.recv("%255[^\n]\n", _msg_buffer) && _recv_delim_lf()) {
-        debug_if(_dbg_on, "AT^ +WIND:24:WiFi Up::%s\r\n", _msg_buffer);
+    debug_if(_dbg_on, "AT^ %s\r\n", _engine.line());
+
+    /* Note: `SPWFXX_RECV_WIFI_UP` matches the whole line */
+    if(_update_ip_from_wifi_up(_engine.line())) { // IPv4 address
+        if(_assoc_pending()) _assoc_state = SPWFSA_ASSOC_UP;
     } else {
-        debug_if(_dbg_on, "\r\nSPWF> Invalid string in SPWFSAxx::_skip_oob (%d)\r\n", __LINE__);
+        if(_assoc_state == SPWFSA_ASSOC_ONGOING) _assoc_state = SPWFSA_ASSOC_LINK_UP;
+    }
+}
+
+/*
+ * Handling oob ("+WIND:40:WiFi Deauthentication")
+ */
+void SPWFSAxx::_deauth_handler(const char *args)
+{
+    debug_if(_dbg_on, "AT~ %s\r\n", _engine.line());
+
+    if(_assoc_pending()) {
+        if(++_assoc_deauths >= SPWFXX_MAX_TRIALS) { // give it three trials
+            _assoc_state = SPWFSA_ASSOC_FAILED;
+        } else {
+            _assoc_state = SPWFSA_ASSOC_ONGOING; // wait for next `+WIND:24`
+        }
     }
 }
-#endif
 
 void SPWFSAxx::setTimeout(uint32_t timeout_ms)
 {
@@ -1128,89 +1997,179 @@ int32_t SPWFSAxx::recv(int spwf_id, void *data, uint32_t amount, bool datagram)
 
     while (true) {
         /* check if any packets are ready for us */
-        for (struct packet **p = &_packets; *p; p = &(*p)->next) {
-            if ((*p)->id == spwf_id) {
-                debug_if(_dbg_on, "\r\nSPWF> Read done on ID %d and length of packet is %d\r\n",spwf_id,(*p)->len);
-                struct packet *q = *p;
-
-                MBED_ASSERT(q->len > 0);
-
-                if(datagram) { // UDP => always remove pkt size
-                    // will always consume a whole pending size
-                    uint32_t ret;
-
-                    debug_if(_dbg_on, "\r\nSPWF> %s():\t\t\t%d:%d (datagram)\r\n", __func__, spwf_id, q->len);
-
-                    ret = (amount < q->len) ? amount : q->len;
-                    memcpy(data, q+1, ret);
-
-                    if (_packets_end == &(*p)->next) {
-                        _packets_end = p;
-                    }
-                    *p = (*p)->next;
-                    free(q);
-
-                    return ret;
-                } else { // TCP
-                    if (q->len <= amount) { // return and remove full packet
-                        memcpy(data, q+1, q->len);
-
-                        if (_packets_end == &(*p)->next) {
-                            _packets_end = p;
-                        }
-                        *p = (*p)->next;
-                        uint32_t len = q->len;
-                        free(q);
-
-                        return len;
-                    } else { // `q->len > amount`, return only partial packet
-                        if(amount > 0) {
-                            memcpy(data, q+1, amount);
-                            q->len -= amount;
-                            memmove(q+1, (uint8_t*)(q+1) + amount, q->len);
-                        }
-
-                        return amount;
-                    }
-                }
-            }
+        int32_t ret = recvQueued(spwf_id, data, amount, datagram);
+        if(ret >= 0) {
+            return ret;
         }
 
         /* check for pending data on module */
         {
             int len;
+            bool direct;
 
-            len = _read_in_pkt(spwf_id, false);
+            /* nothing queued for this socket: next chunk gets read directly into `data` if it fits */
+            len = _read_in_pkt(spwf_id, false, (char*)data, amount, datagram, &direct);
             if(len <= 0)  { /* SPWFXX error or no more data to be read */
+                _winds_restore(); // application is going to wait for "+WIND:55"
                 return -1;
             }
+
+            if(direct) { /* data has not been queued, i.e. has been read directly */
+                MBED_ASSERT((uint32_t)len <= amount);
+                return len;
+            }
         }
     }
 }
 
-void SPWFSAxx::_process_winds(void) {
-    do {
-        if(_parser.process_oob()) {
-            /* nothing else to do! */;
-        } else {
-            debug_if(_dbg_on, "%s():\t\tNo (more) oob's found!\r\n", __func__);
-            return; // no (more) oob's found
+int32_t SPWFSAxx::recvQueued(int spwf_id, void *data, uint32_t amount, bool datagram)
+{
+    uint32_t ret;
+    bool relieved = false;
+
+    {
+        PKT_SYNC_HANDLER;
+
+        struct packet *q = _packets[spwf_id];
+        if (q == 0) {
+            return -1;
         }
-    } while(true);
+
+        SPWFXX_TRACE(SPWFSA_TRACE_RECV, spwf_id, ((q->len < amount) ? q->len : amount), datagram,
+                     "\r\nSPWF> Read done on ID %d and length of packet is %d\r\n",spwf_id,q->len);
+
+        MBED_ASSERT(q->id == spwf_id);
+        MBED_ASSERT(q->len > 0);
+
+        if(datagram) { // UDP => always remove pkt size
+            // will always consume a whole pending size
+            MBED_ASSERT(q->offset == 0);
+
+            ret = (amount < q->len) ? amount : q->len;
+            memcpy(data, q+1, ret);
+
+            _dequeue_packet(spwf_id);
+            relieved = _release_packet(q);
+        } else { // TCP
+            if (q->len <= amount) { // return and remove (rest of) packet
+                memcpy(data, (uint8_t*)(q+1) + q->offset, q->len);
+
+                _dequeue_packet(spwf_id);
+                ret = q->len;
+                relieved = _release_packet(q);
+            } else { // `q->len > amount`, return only partial packet
+                if(amount > 0) {
+                    memcpy(data, (uint8_t*)(q+1) + q->offset, amount);
+                    q->offset += amount;
+                    q->len -= amount;
+                }
+
+                ret = amount;
+            }
+        }
+    }
+
+    if(relieved) {
+        _packet_pool_relieved();
+    }
+
+    return ret;
+}
+
+int32_t SPWFSAxx::recvv(int spwf_id, struct chunk *chunks, unsigned int count, bool datagram)
+{
+    BlockExecuter bh_handler(Callback<void()>(this, &SPWFSAxx::_execute_bottom_halves));
+
+    /* nothing queued for this socket: queue pending data from module */
+    if(_packets[spwf_id] == 0) {
+        if(_read_in_pkt(spwf_id, false) <= 0) { /* SPWFXX error or no more data to be read */
+            _winds_restore(); // application is going to wait for "+WIND:55"
+            return -1;
+        }
+    }
+
+    return recvvQueued(spwf_id, chunks, count, datagram);
+}
+
+int32_t SPWFSAxx::recvvQueued(int spwf_id, struct chunk *chunks, unsigned int count, bool datagram)
+{
+    struct packet *q;
+    uint32_t total = 0U, chunk_offset = 0U, to_copy;
+    unsigned int chunk_idx = 0;
+    bool relieved = false;
+
+    {
+        PKT_SYNC_HANDLER;
+
+        if(_packets[spwf_id] == 0) {
+            return -1;
+        }
+
+        /* copy queued data straight into the destination chunks */
+        while(((q = _packets[spwf_id]) != 0) && (chunk_idx < count)) {
+            MBED_ASSERT(q->id == spwf_id);
+            MBED_ASSERT(q->len > 0);
+
+            to_copy = chunks[chunk_idx].len - chunk_offset;
+            if(to_copy > q->len) to_copy = q->len;
+
+            memcpy(chunks[chunk_idx].buffer + chunk_offset, (uint8_t*)(q+1) + q->offset, to_copy);
+            total += to_copy;
+            q->offset += to_copy;
+            q->len -= to_copy;
+
+            chunk_offset += to_copy;
+            if(chunk_offset == chunks[chunk_idx].len) {
+                chunk_idx++;
+                chunk_offset = 0U;
+            }
+
+            if((q->len == 0) || (datagram && (chunk_idx == count))) { // UDP => always remove whole packet
+                _dequeue_packet(spwf_id);
+                relieved |= _release_packet(q);
+
+                if(datagram) break;
+            }
+        }
+
+        SPWFXX_TRACE(SPWFSA_TRACE_RECV, spwf_id, total, datagram,
+                     "\r\nSPWF> %s():\t\t\t%d:%d\r\n", __func__, spwf_id, total);
+    }
+
+    if(relieved) {
+        _packet_pool_relieved();
+    }
+
+    return total;
+}
+
+void SPWFSAxx::_process_winds(void) {
+    while(readable()) {
+        _dispatch_event(_recv_event());
+    }
+    debug_if(_dbg_on, "%s():\t\tNo (more) oob's found!\r\n", __func__);
 }
 
 /* Note: returns
  * '>=0'             in case of success, amount of read in data (in bytes)
- * 'SPWFXX_ERR_OOM'  in case of "out of memory"
+ * 'SPWFXX_ERR_OOM'  in case of exhausted packet pool
  * 'SPWFXX_ERR_READ' in case of other `_read_in_packet()` error
  * 'SPWFXX_ERR_LEN'  in case of `_read_len()` error
+ *
+ * Note: if `buffer` is not NULL and the next pending chunk fits into `size` bytes,
+ *       the chunk is read directly into `buffer` instead of being queued (reported via `direct`)
+ * Note: if `SPWFSA_COALESCE_READS` is enabled, as many pending chunks as fit into the available
+ *       buffer space (i.e. `size` resp. free packet pool slots) are read in with one single `SOCKR`
+ *       (but never more than one `datagram` directly into `buffer`)
  */
-int SPWFSAxx::_read_in_pkt(int spwf_id, bool close) {
+int SPWFSAxx::_read_in_pkt(int spwf_id, bool close, char *buffer, uint32_t size, bool datagram, bool *direct) {
     int pending;
     uint32_t wind_pending;
     BlockExecuter netsock_wa_obj(Callback<void()>(this, &SPWFSAxx::_unblock_event_callback),
                                  Callback<void()>(this, &SPWFSAxx::_block_event_callback)); /* do not call (external) callback in IRQ context while receiving */
 
+    if(direct != NULL) *direct = false;
+
     _process_winds(); // perform async indication handling
 
     if(close) { // read in all data
@@ -1219,12 +2178,11 @@ int SPWFSAxx::_read_in_pkt(int spwf_id, bool close) {
         if(pending > 0) {
             /* reset pending data sizes */
             _reset_pending_pkt_sizes(spwf_id);
-            /* create new entry for pending size */
-            _add_pending_pkt_size(spwf_id, (uint32_t)pending);
-#ifndef NDEBUG
+            /* create new entries for pending size (must fit into packet pool slots) */
+            _add_pending_packet_sz(spwf_id, (uint32_t)pending);
+
             wind_pending = _get_pending_pkt_size(spwf_id);
-            MBED_ASSERT(pending == (int)wind_pending);
-#endif
+            MBED_ASSERT(wind_pending > 0);
         } else if(pending < 0) {
             debug_if(_dbg_on, "\r\nSPWF> %s(), #%d:`_read_len()` failed (%d)!\r\n", __func__, __LINE__, pending);
         }
@@ -1239,7 +2197,8 @@ int SPWFSAxx::_read_in_pkt(int spwf_id, bool close) {
 
                 if(wind_pending == 0) {
                     /* betzw - WORK AROUND module FW issues: create new entry for pending size */
-                    debug_if(_dbg_on, "%s():\t\tAdd packet w/o WIND (%d)!\r\n", __func__, pending);
+                    SPWFXX_TRACE(SPWFSA_TRACE_PENDING_NO_WIND, spwf_id, pending, 0,
+                                 "%s():\t\tAdd packet w/o WIND (%d)!\r\n", __func__, pending);
                     _add_pending_packet_sz(spwf_id, (uint32_t)pending);
 
                     pending = wind_pending = _get_pending_pkt_size(spwf_id);
@@ -1252,8 +2211,36 @@ int SPWFSAxx::_read_in_pkt(int spwf_id, bool close) {
     }
 
     if((pending > 0) && (wind_pending > 0)) {
-        int ret = _read_in_packet(spwf_id, wind_pending);
-        if(ret < 0) { /* "out of memory" or `_read_in_packet()` error */
+        bool read_direct = ((buffer != NULL) && (wind_pending <= size));
+        unsigned int count = 1;
+        int ret;
+
+#if SPWFSA_COALESCE_READS
+        {
+            uint32_t next;
+
+            while((next = _get_pending_pkt_size(spwf_id, count)) > 0) {
+                if(read_direct) {
+                    if(datagram || ((wind_pending + next) > size)) break;
+                } else {
+                    if(count >= _packet_pool.available()) break;
+                }
+
+                wind_pending += next;
+                count++;
+            }
+        }
+#endif // SPWFSA_COALESCE_READS
+
+        /* block asynchronous indications during `SOCKR`
+         * (outside of a burst they are held switched off for the application's next read, see `_winds_hold()`) */
+        if(!_winds_off()) return SPWFXX_ERR_READ;
+        ret = _read_in_packet(spwf_id, count, wind_pending, read_direct ? buffer : NULL);
+        _winds_hold();
+
+        if(ret == SPWFXX_ERR_OOM) { /* packet pool exhausted, nothing has been read in */
+            return ret;
+        } else if(ret < 0) { /* `_read_in_packet()` error */
             /* we do not know if data is still pending at this point
                but leaving the pending data bit set might lead to an endless loop */
             _clear_pending_data(spwf_id);
@@ -1263,11 +2250,18 @@ int SPWFSAxx::_read_in_pkt(int spwf_id, bool close) {
             return ret;
         }
 
+        if(read_direct && (direct != NULL)) *direct = true;
+
         if((_get_cumulative_size(spwf_id) == 0) && (pending <= (int)wind_pending)) {
             _clear_pending_data(spwf_id);
         }
     } else if(pending < 0) { /* 'SPWFXX_ERR_LEN' error */
         MBED_ASSERT(pending == SPWFXX_ERR_LEN);
+        /* module does not know the socket anymore (its "+WIND:58" might have been dropped while WINDs were switched off) */
+        int internal_id = _associated_interface.get_internal_id(spwf_id);
+        if(internal_id != SPWFSA_SOCKET_COUNT) {
+            _associated_interface._ids[internal_id].server_gone = true;
+        }
         /* we do not know if data is still pending at this point
            but leaving the pending data bit set might lead to an endless loop */
         _clear_pending_data(spwf_id);
@@ -1285,3 +2279,180 @@ int SPWFSAxx::_read_in_pkt(int spwf_id, bool close) {
 
     return (int)wind_pending;
 }
+
+/* Single pass parser for scan result lines, reading directly from the UART (i.e. without line buffer) */
+class SpwfScanLineParser {
+public:
+    SpwfScanLineParser(ATCmdParser &parser) : _parser(parser) {
+        next();
+    }
+
+    int cur(void) const {
+        return _c;
+    }
+
+    void next(void) {
+        _c = _parser.getc();
+    }
+
+    bool eol(void) const {
+        return ((_c < 0) || (_c == '\r')); // end of line or timeout
+    }
+
+    void skip_blanks(void) {
+        while(_c == ' ') next();
+    }
+
+    void skip_word(void) {
+        skip_blanks();
+        while(!eol() && (_c != ' ')) next();
+    }
+
+    /* consume rest of line incl. line delimiters */
+    void skip_line(void) {
+        while(!eol()) next();
+        if(_c == '\r') _parser.getc(); // '\n'
+    }
+
+    bool expect(const char *str) {
+        skip_blanks();
+        for(; *str != '\0'; str++) {
+            if(_c != *str) return false;
+            next();
+        }
+        return true;
+    }
+
+    bool number(int *val) {
+        bool neg = false;
+        int ret = 0;
+
+        skip_blanks();
+        if(_c == '-') {
+            neg = true;
+            next();
+        }
+        if(!_is_digit(_c)) return false;
+        while(_is_digit(_c)) {
+            ret = (ret * 10) + (_c - '0');
+            next();
+        }
+
+        *val = neg ? -ret : ret;
+        return true;
+    }
+
+    bool hex_byte(uint8_t *val) {
+        int hi, lo;
+
+        if((hi = _hex_val(_c)) < 0) return false;
+        next();
+        if((lo = _hex_val(_c)) < 0) return false;
+        next();
+
+        *val = (uint8_t)((hi << 4) | lo);
+        return true;
+    }
+
+private:
+    static bool _is_digit(int c) {
+        return ((c >= '0') && (c <= '9'));
+    }
+
+    static int _hex_val(int c) {
+        if(_is_digit(c)) return (c - '0');
+        if((c >= 'a') && (c <= 'f')) return (c - 'a' + 10);
+        if((c >= 'A') && (c <= 'F')) return (c - 'A' + 10);
+        return -1;
+    }
+
+    ATCmdParser &_parser;
+    int _c;
+};
+
+/* Parses the rest (i.e. after the horizontal tab) of a scan result line, e.g.
+ * "BSS 00:11:22:33:44:55 CHAN: 06 RSSI: -54 SSID: 'my ssid' CAPS: 0431 WPA2 WPS"
+ * Note: the line (incl. its delimiters) is always consumed completely
+ */
+bool SPWFSAxx::_recv_ap_line(nsapi_wifi_ap_t *ap)
+{
+    static const char ssid_end[] = "' CAPS:";
+    SpwfScanLineParser p(_parser);
+    unsigned int matched = 0;
+    unsigned int len = 0;
+    int value;
+
+    ap->security = NSAPI_SECURITY_UNKNOWN;
+
+    /* BSSID */
+    p.skip_word();
+    p.skip_blanks();
+    for(unsigned int i = 0; i < sizeof(ap->bssid); i++) {
+        if(((i > 0) && !p.expect(":")) || !p.hex_byte(&ap->bssid[i])) goto ap_line_error;
+    }
+
+    /* channel & RSSI */
+    if(!(p.expect("CHAN:") && p.number(&value))) goto ap_line_error;
+    ap->channel = value;
+    if(!(p.expect("RSSI:") && p.number(&value))) goto ap_line_error;
+    ap->rssi = value;
+
+    /* SSID (might itself contain `'`, the closing one is the one followed by " CAPS:") */
+    if(!(p.expect("SSID:") && p.expect("'"))) goto ap_line_error;
+    while(!p.eol() && (ssid_end[matched] != '\0')) {
+        char c = (char)p.cur();
+        p.next();
+
+        if(c == ssid_end[matched]) {
+            matched++;
+            continue;
+        }
+
+        /* no end of SSID, flush partial match */
+        for(unsigned int i = 0; i < matched; i++) {
+            if(len < (sizeof(ap->ssid) - 1)) ap->ssid[len++] = ssid_end[i];
+        }
+        matched = 0;
+
+        if(c == ssid_end[0]) {
+            matched = 1;
+        } else if(len < (sizeof(ap->ssid) - 1)) {
+            ap->ssid[len++] = c;
+        }
+    }
+    ap->ssid[len] = '\0';
+    if(ssid_end[matched] != '\0') goto ap_line_error;
+
+    /* skip capabilities (e.g. `0421`) */
+    p.skip_word();
+    p.skip_blanks();
+
+    /* determine security */
+    if(p.cur() != 'W') { // no security
+        ap->security = NSAPI_SECURITY_NONE;
+    } else {
+        char word[4];
+
+        p.next();
+        for(len = 0; !p.eol() && (p.cur() != ' '); p.next()) {
+            if(len < (sizeof(word) - 1)) word[len++] = (char)p.cur();
+        }
+        word[len] = '\0';
+
+        if(strcmp("EP", word) == 0) {
+            ap->security = NSAPI_SECURITY_WEP;
+        } else if(strcmp("PA2", word) == 0) {
+            ap->security = NSAPI_SECURITY_WPA2;
+        } else if(strcmp("PA", word) == 0) {
+            /* got a "WPA", check for "WPA2" */
+            ap->security = p.eol() ? NSAPI_SECURITY_WPA : NSAPI_SECURITY_WPA_WPA2;
+        }
+    }
+
+    p.skip_line();
+    return true;
+
+ap_line_error:
+    p.skip_line();
+    return false;
+}
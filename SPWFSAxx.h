@@ -20,11 +20,18 @@
 #include "mbed.h"
 #include "ATCmdParser.h"
 #include "BlockExecuter.h"
+#include "SpwfProtocolEngine.h"
 
 /* Common SPWFSAxx macros */
 #define SPWFXX_WINDS_LOW_ON         "0x00000000"
 #define SPWFXX_DEFAULT_BAUD_RATE    115200
+#if defined(MBED_CONF_IDW0XX1_CONSOLE_SPEED)
+#define SPWFXX_BAUD_RATE            (MBED_CONF_IDW0XX1_CONSOLE_SPEED) // console speed to be negotiated at startup
+#else
+#define SPWFXX_BAUD_RATE            SPWFXX_DEFAULT_BAUD_RATE
+#endif
 #define SPWFXX_MAX_TRIALS           3
+#define SPWFXX_WIND_CODES           (90) // number of known asynchronous indication codes (i.e. `+WIND:0` to `+WIND:89`)
 
 #if !defined(SPWFSAXX_RTS_PIN)
 #define SPWFSAXX_RTS_PIN    NC
@@ -45,6 +52,178 @@
 
 #define PENDING_DATA_SLOTS          (13)
 
+/* Number of receive packet slots (each one holding up to `SPWFXX_SEND_RECV_PKTSIZE` bytes) */
+#if defined(MBED_CONF_IDW0XX1_PACKET_POOL_SIZE)
+#define SPWFSA_PACKET_POOL_SIZE     (MBED_CONF_IDW0XX1_PACKET_POOL_SIZE)
+#else
+#define SPWFSA_PACKET_POOL_SIZE     (8)
+#endif
+
+/* Read in several pending packets with one single `AT+S.SOCKR` (requires module FW support) */
+#if defined(MBED_CONF_IDW0XX1_COALESCE_READS)
+#define SPWFSA_COALESCE_READS       (MBED_CONF_IDW0XX1_COALESCE_READS)
+#else
+#define SPWFSA_COALESCE_READS       (0)
+#endif
+
+/* Per AT command class latency histograms (for profiling only) */
+#if defined(MBED_CONF_IDW0XX1_AT_LATENCY_STATS)
+#define SPWFSA_AT_LATENCY_STATS     (MBED_CONF_IDW0XX1_AT_LATENCY_STATS)
+#else
+#define SPWFSA_AT_LATENCY_STATS     (0)
+#endif
+
+/* AT command classes latencies are tracked for */
+typedef enum {
+    SPWFSA_AT_SOCKW = 0,
+    SPWFSA_AT_SOCKR,
+    SPWFSA_AT_SOCKQ,
+    SPWFSA_AT_SOCKON,
+    SPWFSA_AT_SOCKC,
+    SPWFSA_AT_STS,
+    SPWFSA_AT_SCFG,
+    SPWFSA_AT_GCFG,
+    SPWFSA_AT_WIFI,
+    SPWFSA_AT_SCAN,
+    SPWFSA_AT_OTHER,
+    SPWFSA_AT_CLASS_COUNT
+} spwfsa_at_class_t;
+
+/* Latency histogram of an AT command class (time from sending the command until its `OK`)
+ *
+ * Bucket upper bounds: 250us, 500us, 1ms, 2ms, 5ms, 10ms, 20ms, 50ms, 100ms, 500ms, 1s, (unbounded)
+ */
+#define SPWFSA_AT_LATENCY_BUCKETS   (12)
+
+typedef struct {
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t buckets[SPWFSA_AT_LATENCY_BUCKETS];
+} spwfsa_at_latency_t;
+
+/* Binary event trace ring (number of events, must be a power of 2, `0` disables tracing).
+ * When enabled, it replaces `debug_if()` printing on the hot paths of the driver. */
+#if defined(MBED_CONF_IDW0XX1_TRACE_BUFFER_SIZE)
+#define SPWFSA_TRACE_SIZE           (MBED_CONF_IDW0XX1_TRACE_BUFFER_SIZE)
+#else
+#define SPWFSA_TRACE_SIZE           (0)
+#endif
+#if (SPWFSA_TRACE_SIZE & (SPWFSA_TRACE_SIZE - 1)) != 0
+#error idw0xx1.trace-buffer-size must be a power of 2
+#endif
+
+/* Maximum age (in ms) of cached network parameters (`0` disables caching of the respective value) */
+#if defined(MBED_CONF_IDW0XX1_IP_CACHE_TIMEOUT)
+#define SPWFSA_IP_CACHE_TIMEOUT         (MBED_CONF_IDW0XX1_IP_CACHE_TIMEOUT)
+#else
+#define SPWFSA_IP_CACHE_TIMEOUT         (60000)
+#endif
+#if defined(MBED_CONF_IDW0XX1_GATEWAY_CACHE_TIMEOUT)
+#define SPWFSA_GATEWAY_CACHE_TIMEOUT    (MBED_CONF_IDW0XX1_GATEWAY_CACHE_TIMEOUT)
+#else
+#define SPWFSA_GATEWAY_CACHE_TIMEOUT    (60000)
+#endif
+#if defined(MBED_CONF_IDW0XX1_NETMASK_CACHE_TIMEOUT)
+#define SPWFSA_NETMASK_CACHE_TIMEOUT    (MBED_CONF_IDW0XX1_NETMASK_CACHE_TIMEOUT)
+#else
+#define SPWFSA_NETMASK_CACHE_TIMEOUT    (60000)
+#endif
+#if defined(MBED_CONF_IDW0XX1_RSSI_CACHE_TIMEOUT)
+#define SPWFSA_RSSI_CACHE_TIMEOUT       (MBED_CONF_IDW0XX1_RSSI_CACHE_TIMEOUT)
+#else
+#define SPWFSA_RSSI_CACHE_TIMEOUT       (1000)
+#endif
+#define SPWFSA_CACHE_NO_TIMEOUT         (0xFFFFFFFFUL) // never gets stale (used for MAC address)
+
+/* Fast reconnect (IDW04A1 only): `disconnect()` just switches the radio off, so that a following `connect()`
+ * with unchanged credentials can switch it on again without flash write & module reset */
+#if defined(MBED_CONF_IDW0XX1_FAST_RECONNECT) && (MBED_CONF_IDW0XX1_EXPANSION_BOARD == IDW04A1)
+#define SPWFSA_FAST_RECONNECT           (MBED_CONF_IDW0XX1_FAST_RECONNECT)
+#else
+#define SPWFSA_FAST_RECONNECT           (0)
+#endif
+
+/* Duration (in ms) of the phases of the last successful `connect()` */
+typedef struct {
+    uint32_t startup_ms;    // HW reset & initial module setup (only if not yet initialized)
+    uint32_t config_ms;     // writing configuration (skipped for unchanged credentials)
+    uint32_t reset_ms;      // saving configuration to flash & SW reset (skipped by fast reconnect)
+    uint32_t join_ms;       // waiting for association & IP address
+    uint32_t total_ms;
+    bool fast;              // fast reconnect has been used
+} spwfsa_connect_timing_t;
+
+/* Socket close statistics (see `SPWFSAxx::getCloseStats()`) */
+typedef struct {
+    uint32_t closed;            // sockets closed successfully
+    uint32_t deferred;          // thereof closed in the background (`closeDeferred()`)
+    uint32_t failed;            // closes for which `AT+S.SOCKC` failed
+    uint32_t drain_bytes;       // pending data read in (and discarded) while closing
+    uint32_t last_latency_ms;   // time from close request until `AT+S.SOCKC` succeeded (last close)
+    uint32_t max_latency_ms;    // maximum of above
+} spwfsa_close_stats_t;
+
+/* Association state (see `SPWFSAxx::connectStart()`) */
+typedef enum {
+    SPWFSA_ASSOC_IDLE = 0,
+    SPWFSA_ASSOC_ONGOING,   // waiting for `+WIND:24:WiFi Up`
+    SPWFSA_ASSOC_LINK_UP,   // got `+WIND:24:WiFi Up` w/o IPv4 address, still waiting for DHCP
+    SPWFSA_ASSOC_UP,        // associated & got IPv4 address
+    SPWFSA_ASSOC_FAILED     // too many deauthentications (`+WIND:40`)
+} spwfsa_assoc_state_t;
+
+/* Cached network parameters */
+typedef enum {
+    SPWFSA_CACHE_IP = 0,
+    SPWFSA_CACHE_GATEWAY,
+    SPWFSA_CACHE_NETMASK,
+    SPWFSA_CACHE_RSSI,
+    SPWFSA_CACHE_MAC,
+    SPWFSA_CACHE_COUNT
+} spwfsa_cache_field_t;
+
+/* Trace event ids (`arg0`, `arg1`) */
+typedef enum {
+    SPWFSA_TRACE_SEND = 0,      // AT+S.SOCKW (bytes, bytes sent before)
+    SPWFSA_TRACE_RECV,          // data returned to application (bytes, datagram)
+    SPWFSA_TRACE_READ_LEN,      // AT+S.SOCKQ (pending bytes, -)
+    SPWFSA_TRACE_READ_IN,       // AT+S.SOCKR (bytes, number of chunks)
+    SPWFSA_TRACE_READ_DIRECT,   // read in into application buffer (bytes, -)
+    SPWFSA_TRACE_READ_QUEUED,   // read in into packet pool (bytes, number of packets)
+    SPWFSA_TRACE_PENDING_DATA,  // +WIND:55 (bytes, valid socket)
+    SPWFSA_TRACE_PENDING_NO_WIND, // pending data without +WIND:55 (bytes, -)
+    SPWFSA_TRACE_SOCK_CLOSED,   // +WIND:58 (-, -)
+    SPWFSA_TRACE_WINDS_OFF,     // asynchronous indications switched off (-, -)
+    SPWFSA_TRACE_WINDS_ON,      // asynchronous indications switched on (-, -)
+    SPWFSA_TRACE_EVENT_COUNT
+} spwfsa_trace_id_t;
+
+/* Filter for streaming scans (members set to `NULL`, `0` resp. `NSAPI_SECURITY_UNKNOWN` match any AP) */
+typedef struct {
+    const char *ssid;           // SSID to look for
+    int8_t min_rssi;            // minimum signal strength (in dBm, i.e. negative)
+    nsapi_security_t security;  // security type
+} spwfsa_scan_filter_t;
+
+/* Streaming scan callback (return `false` to stop delivering further results) */
+typedef Callback<bool(const WiFiAccessPoint &)> spwfsa_scan_cb_t;
+
+typedef struct {
+    uint32_t timestamp;         // `us_ticker_read()`
+    uint8_t event;              // `spwfsa_trace_id_t`
+    int8_t spwf_id;             // module socket id (`-1` for none)
+    int32_t arg0;
+    int32_t arg1;
+} spwfsa_trace_event_t;
+
+/* Record trace event (if tracing is enabled), otherwise print debug message */
+#if SPWFSA_TRACE_SIZE > 0
+#define SPWFXX_TRACE(event, spwf_id, arg0, arg1, ...)   _trace((event), (spwf_id), (int32_t)(arg0), (int32_t)(arg1))
+#else
+#define SPWFXX_TRACE(event, spwf_id, arg0, arg1, ...)   debug_if(_dbg_on, __VA_ARGS__)
+#endif
+
 /* Pending data packets size buffer */
 class SpwfRealPendingPackets {
 public:
@@ -52,12 +231,18 @@ public:
         reset();
     }
 
-    void add(uint32_t new_cum_size) {
+    /* returns false if all slots are in use (e.g. while the packet pool is exhausted),
+     * the remaining data is then left on the module to be queried later (`SOCKQ`) */
+    bool add(uint32_t new_cum_size) {
         MBED_ASSERT(new_cum_size >= cumulative_size);
 
         if(new_cum_size == cumulative_size) {
             /* nothing to do */
-            return;
+            return true;
+        }
+
+        if(count() == (PENDING_DATA_SLOTS - 1)) {
+            return false;
         }
 
         /* => `new_cum_size > cumulative_size` */
@@ -67,6 +252,7 @@ public:
         last_pkt_ptr = (last_pkt_ptr + 1) % PENDING_DATA_SLOTS;
 
         MBED_ASSERT(first_pkt_ptr != last_pkt_ptr);
+        return true;
     }
 
     uint32_t get(void) {
@@ -75,6 +261,17 @@ public:
         return real_pkt_sizes[first_pkt_ptr];
     }
 
+    /* get size of `idx`-th pending packet (`0` is the first one) */
+    uint32_t get(unsigned int idx) {
+        if(idx >= count()) return 0;
+
+        return real_pkt_sizes[(first_pkt_ptr + idx) % PENDING_DATA_SLOTS];
+    }
+
+    unsigned int count(void) {
+        return (last_pkt_ptr + PENDING_DATA_SLOTS - first_pkt_ptr) % PENDING_DATA_SLOTS;
+    }
+
     uint32_t cumulative(void) {
         return cumulative_size;
     }
@@ -111,6 +308,83 @@ private:
     uint32_t cumulative_size;
 };
 
+/* Fixed-size slot pool for received packets (avoids heap usage while receiving) */
+template<size_t SLOT_SIZE, unsigned int SLOT_COUNT>
+class SpwfPacketPool {
+public:
+    SpwfPacketPool() {
+        free_slots = NULL;
+        for(unsigned int i = SLOT_COUNT; i > 0; i--) {
+            slots[i-1].next = free_slots;
+            free_slots = &slots[i-1];
+        }
+
+        used_cnt = 0;
+        high_water_mark = 0;
+        exhausted_cnt = 0;
+    }
+
+    void *alloc(void) {
+        slot_t *slot = free_slots;
+
+        if(slot == NULL) {
+            exhausted_cnt++;
+            return NULL;
+        }
+
+        free_slots = slot->next;
+        if(++used_cnt > high_water_mark) {
+            high_water_mark = used_cnt;
+        }
+
+        return slot;
+    }
+
+    void free(void *ptr) {
+        slot_t *slot = (slot_t*)ptr;
+
+        MBED_ASSERT((slot >= &slots[0]) && (slot < &slots[SLOT_COUNT]));
+        MBED_ASSERT(used_cnt > 0);
+
+        slot->next = free_slots;
+        free_slots = slot;
+        used_cnt--;
+    }
+
+    bool empty(void) {
+        return (free_slots == NULL);
+    }
+
+    unsigned int available(void) {
+        return SLOT_COUNT - used_cnt;
+    }
+
+    unsigned int used(void) {
+        return used_cnt;
+    }
+
+    unsigned int max_used(void) {
+        return high_water_mark;
+    }
+
+    unsigned int exhausted(void) {
+        return exhausted_cnt;
+    }
+
+private:
+    union slot_t {
+        slot_t  *next;
+        uint8_t data[SLOT_SIZE];
+    };
+
+    slot_t slots[SLOT_COUNT];
+    slot_t *free_slots;
+
+    unsigned int used_cnt;
+    unsigned int high_water_mark;
+    unsigned int exhausted_cnt;
+};
+
 class SpwfSAInterface;
 
 /** SPWFSAxx Interface class.
@@ -143,6 +417,31 @@ public:
      */
     bool connect(const char *ap, const char *passPhrase, int securityMode);
 
+    /**
+     * Start connecting SPWFSAxx to AP without waiting for the association to complete
+     *
+     * @param ap the name of the AP
+     * @param passPhrase the password of AP
+     * @param securityMode the security mode of AP (WPA/WPA2, WEP, Open)
+     * @return true only if the association has been started successfully
+     * @note progress has to be polled with `pollAssociation()`
+     */
+    bool connectStart(const char *ap, const char *passPhrase, int securityMode);
+
+    /**
+     * Process received asynchronous indications & return association state (does not block)
+     *
+     * @return current association state
+     */
+    spwfsa_assoc_state_t pollAssociation(void);
+
+    /**
+     * Number of deauthentications (`+WIND:40`) received during current association
+     */
+    int getAssociationRetries(void) {
+        return _assoc_deauths;
+    }
+
     /**
      * Disconnect SPWFSAxx from AP
      *
@@ -180,9 +479,73 @@ public:
 
     /** Gets the current radio signal strength for active connection
      *
+     * @param refresh   read it from the module even if the cached value is still fresh
      * @return          Connection strength in dBm (negative value)
      */
-    int8_t getRssi();
+    int8_t getRssi(bool refresh = false);
+
+    /**
+     * Get usage statistics of the receive packet pool
+     *
+     * @param max_used maximum number of pool slots which have been in use at the same time
+     * @param exhausted number of packet allocations which failed due to an exhausted pool
+     */
+    void getPacketPoolStats(unsigned int *max_used, unsigned int *exhausted);
+
+    /**
+     * Get receive path statistics
+     *
+     * @param at_cmds number of AT commands issued for receiving data (incl. switching WINDs on/off)
+     * @param bytes number of bytes received from the module
+     */
+    void getRecvStats(uint32_t *at_cmds, uint32_t *bytes);
+
+    /**
+     * Get socket close statistics
+     *
+     * @param stats placeholder for the statistics
+     */
+    void getCloseStats(spwfsa_close_stats_t *stats) {
+        *stats = _close_stats;
+    }
+
+    /**
+     * Get duration of the phases of the last successful connect
+     *
+     * @param timing placeholder for the phase durations
+     */
+    void getConnectTiming(spwfsa_connect_timing_t *timing) {
+        *timing = _connect_timing;
+    }
+
+    /**
+     * Get latency histogram of an AT command class
+     *
+     * @param cmd_class AT command class
+     * @param stats placeholder for histogram
+     * @return true only if latency statistics are enabled and `cmd_class` is valid
+     */
+    bool getAtLatencyStats(spwfsa_at_class_t cmd_class, spwfsa_at_latency_t *stats);
+
+    /**
+     * Reset latency histograms of all AT command classes
+     */
+    void resetAtLatencyStats(void);
+
+    /**
+     * Read (and remove) recorded trace events, oldest first
+     *
+     * @param events placeholder for events
+     * @param count maximum number of events to read
+     * @return number of events read (events overwritten before being read are skipped)
+     */
+    unsigned int readTrace(spwfsa_trace_event_t *events, unsigned int count);
+
+    /* (part of a) source/destination buffer for socket data (scatter-gather I/O) */
+    struct chunk {
+        char *buffer;
+        uint32_t len;
+    };
 
     /**
      * Sends data to an open socket
@@ -195,6 +558,17 @@ public:
      */
     nsapi_size_or_error_t send(int spwf_id, const void *data, uint32_t amount, int internal_id);
 
+    /**
+     * Sends data gathered from several buffers to an open socket
+     *
+     * @param spwf_id module id of socket to send to
+     * @param chunks buffers holding the data to be sent (not modified)
+     * @param count number of buffers
+     * @param internal_id driver id of socket to send to
+     * @return number of written bytes on success, negative on failure
+     */
+    nsapi_size_or_error_t sendv(int spwf_id, const struct chunk *chunks, unsigned int count, int internal_id);
+
     /**
      * Receives data from an open socket
      *
@@ -206,6 +580,42 @@ public:
      */
     int32_t recv(int id, void *data, uint32_t amount, bool datagram);
 
+    /**
+     * Receives data already queued for an open socket (without talking to the module)
+     *
+     * @param spwf_id id to receive from
+     * @param data placeholder for returned information
+     * @param amount number of bytes to be received
+     * @param datagram receive a datagram packet
+     * @return the number of bytes received, negative if no data is queued
+     * @note takes only the packet queue lock, i.e. does not need the driver (UART) lock to be held
+     */
+    int32_t recvQueued(int spwf_id, void *data, uint32_t amount, bool datagram);
+
+    /**
+     * Receives data from an open socket, scattering it into several buffers
+     *
+     * @param spwf_id module id of socket to receive from
+     * @param chunks buffers to be filled one after the other
+     * @param count number of buffers
+     * @param datagram receive a datagram packet
+     * @return the number of bytes received, negative if no data is available
+     */
+    int32_t recvv(int spwf_id, struct chunk *chunks, unsigned int count, bool datagram);
+
+    /**
+     * Receives data already queued for an open socket (without talking to the module),
+     * scattering it into several buffers
+     *
+     * @param spwf_id id to receive from
+     * @param chunks buffers in which to store the received data
+     * @param count number of buffers
+     * @param datagram receive a datagram packet
+     * @return the number of bytes received, negative if no data is queued
+     * @note takes only the packet queue lock, i.e. does not need the driver (UART) lock to be held
+     */
+    int32_t recvvQueued(int spwf_id, struct chunk *chunks, unsigned int count, bool datagram);
+
     /**
      * Closes a socket
      *
@@ -214,6 +624,21 @@ public:
      */
     bool close(int id);
 
+    /**
+     * Closes a socket in the background, i.e. without waiting for its pending data to be drained
+     *
+     * @param spwf_id id of socket to close
+     * @note draining & closing is done by subsequent calls to `processDeferredCloses()`
+     */
+    void closeDeferred(int spwf_id);
+
+    /**
+     * Perform one (non-blocking) drain resp. close step for each socket closed with `closeDeferred()`
+     *
+     * @return true if there are still sockets to be closed
+     */
+    bool processDeferredCloses(void);
+
     /**
      * Allows timeout to be changed between commands
      *
@@ -257,16 +682,49 @@ private:
     int _pending_sockets_bitmap;
     SpwfRealPendingPackets _pending_pkt_sizes[SPWFSA_SOCKET_COUNT];
 
-    bool _network_lost_flag;
+    bool _network_lost_flag; // network loss recovery ongoing (see `_network_lost_handler_bh()`)
+
+    /* nesting level of `_winds_off()` calls (`> 0` means WINDs are switched off) */
+    unsigned int _winds_off_cnt;
+    /* WINDs kept switched off after the application's last read (see `_winds_hold()`) */
+    bool _winds_held;
+    uint64_t _winds_hold_stamp; // `_ticker_us()`
+    int _baud_rate;
+
+    /* receive path statistics */
+    uint32_t _rx_at_cmd_cnt;
+    uint32_t _rx_bytes_cnt;
+
+    /* deferred closes (indexed by `spwf_id`) & close statistics */
+    int _closing_sockets_bitmap;
+    uint64_t _close_stamps[SPWFSA_SOCKET_COUNT]; // `_ticker_us()`
+    uint8_t _close_trials[SPWFSA_SOCKET_COUNT];
+    spwfsa_close_stats_t _close_stats;
+
     SpwfSAInterface &_associated_interface;
 
     /**
      * Reset SPWFSAxx
      *
+     * @param baud_rate console speed the module restarts with (`0` for current one, only for SW reset)
+     * @param save      save current settings in flash before resetting (only for SW reset)
      * @return true only if SPWFSAxx resets successfully
      */
     bool hw_reset(void);
-    bool reset(void);
+    bool reset(int baud_rate = 0, bool save = true);
+    bool _startup(int mode, bool upgrade_speed);
+
+    /* switch console speed on MCU side */
+    void _set_baud_rate(int baud_rate) {
+        _serial.set_baud(baud_rate);
+        _baud_rate = baud_rate;
+        empty_rx_buffer();
+    }
+
+    /* check that module answers on current console speed */
+    bool _check_link(void) {
+        return (_send_cmd("AT") && _recv_ok());
+    }
 
     /**
      * Check if SPWFSAxx is connected
@@ -302,38 +760,150 @@ private:
     volatile unsigned int _call_event_callback_blocked;
     Callback<void()> _callback_func;
 
+    /* IRQ to driver event thread handoff (lock-free, single consumer):
+     * producers only (atomically) increment `_irq_events`, the event thread only writes `_irq_events_seen` */
+    volatile uint32_t _irq_events;
+    uint32_t _irq_events_seen;
+
+    bool _take_irq_events(void) {
+        uint32_t events = _irq_events;
+
+        if(events == _irq_events_seen) return false;
+        _irq_events_seen = events;
+        return true;
+    }
+
     struct packet {
         struct packet *next;
         int id;
-        uint32_t len;
+        uint32_t len;       // remaining (i.e. not yet consumed) data length
+        uint32_t offset;    // offset of first not yet consumed data byte
         // data follows
-    } *_packets, **_packets_end;
+    };
+
+    /* per socket (i.e. `spwf_id`) FIFO queues of received packets */
+    struct packet *_packets[SPWFSA_SOCKET_COUNT];
+    struct packet **_packets_end[SPWFSA_SOCKET_COUNT];
+
+    SpwfPacketPool<sizeof(struct packet) + SPWFXX_SEND_RECV_PKTSIZE, SPWFSA_PACKET_POOL_SIZE> _packet_pool;
+    bool _packet_pool_oom; // an allocation failed since the last packet has been freed
 
-    void _packet_handler_th(void);
+    /* Note: packet lock must be held, returns true if the pool had been exhausted before */
+    bool _release_packet(struct packet *p) {
+        _packet_pool.free(p);
+        if(_packet_pool_oom) {
+            _packet_pool_oom = false;
+            return true;
+        }
+        return false;
+    }
+
+#if MBED_CONF_RTOS_PRESENT
+    /* protects packet queues & pool (taken inside the driver (UART) lock, never the other way round) */
+    Mutex _pkt_mutex;
+#endif
+
+    void _packet_handler_th(const char *args);
     void _execute_bottom_halves(void);
-    void _network_lost_handler_th(void);
+    void _network_lost_handler_th(const char *args);
     void _network_lost_handler_bh(void);
-    void _hard_fault_handler(void);
-    void _wifi_hwfault_handler(void);
-    void _server_gone_handler(void);
-#if MBED_CONF_IDW0XX1_EXPANSION_BOARD == IDW04A1
-    void _skip_oob(void);
-#endif
-    bool _wait_wifi_hw_started(void);
-    bool _wait_console_active(void);
+    void _hard_fault_handler(const char *args);
+    void _wifi_hwfault_handler(const char *args);
+    void _server_gone_handler(const char *args);
+    void _wifi_up_handler(const char *args);
+
+    /* asynchronous indication handlers indexed by WIND code (`NULL` means just skip) */
+    typedef void (SPWFSAxx::*wind_handler_t)(const char *args);
+    static const wind_handler_t _wind_handlers[SPWFXX_WIND_CODES];
+
+    bool _wait_wind(int code);
+    bool _connect_start(const char *ap, const char *passPhrase, int securityMode);
+    bool _wait_wifi_up(void);
+    void _assoc_completed(void);
+    void _deauth_handler(const char *args);
+
+    bool _assoc_pending(void) {
+        return ((_assoc_state == SPWFSA_ASSOC_ONGOING) || (_assoc_state == SPWFSA_ASSOC_LINK_UP));
+    }
+    bool _wait_wifi_hw_started(void) {
+        return _wait_wind(32); // WiFi Hardware Started
+    }
+    bool _wait_console_active(void) {
+        return _wait_wind(0); // Console active
+    }
     int _read_len(int);
     int _flush_in(char*, int);
     bool _winds_off(void);
     void _winds_on(void);
+    void _winds_hold(void);
+    void _winds_restore(void);
+    void _winds_resync(void);
+#if MBED_CONF_RTOS_PRESENT
+    uint32_t _winds_check_hold(void);
+#endif // MBED_CONF_RTOS_PRESENT
     void _read_in_pending(void);
-    int _read_in_pkt(int spwf_id, bool close);
-    int _read_in_packet(int spwf_id, uint32_t amount);
+    int _read_in_pkt(int spwf_id, bool close, char *buffer = NULL, uint32_t size = 0, bool datagram = false,
+                     bool *direct = NULL);
+    int _read_in_packet(int spwf_id, unsigned int count, uint32_t amount, char *buffer = NULL);
+    void _packet_pool_relieved(void);
     void _recover_from_hard_faults(void);
     void _free_packets(int spwf_id);
+    void _close_cleanup(int spwf_id);
+    void _close_completed(int spwf_id, bool deferred);
     void _free_all_packets(void);
     void _process_winds();
 
-    virtual int _read_in(char*, int, uint32_t) = 0;
+    virtual int _read_in(struct chunk*, unsigned int, int, uint32_t) = 0;
+
+    bool _recv_ap_line(nsapi_wifi_ap_t *ap);
+
+    /* check scan result against `filter` (`NULL` matches any AP) */
+    static bool _scan_filter_match(const nsapi_wifi_ap_t *ap, const spwfsa_scan_filter_t *filter) {
+        if(filter == NULL) return true;
+        if((filter->ssid != NULL) && (strcmp(filter->ssid, ap->ssid) != 0)) return false;
+        if((filter->min_rssi != 0) && (ap->rssi < filter->min_rssi)) return false;
+        if((filter->security != NSAPI_SECURITY_UNKNOWN) && (ap->security != filter->security)) return false;
+        return true;
+    }
+
+    int _read_in_chunks(struct chunk *chunks, unsigned int count) {
+        int total = 0;
+
+        for(unsigned int i = 0; i < count; i++) {
+            int read = _parser.read(chunks[i].buffer, chunks[i].len);
+            if(read != (int)chunks[i].len) {
+                return -1;
+            }
+            total += read;
+        }
+
+        return total;
+    }
+
+    /* write out `amount` bytes starting at chunk `*idx`, offset `*offset`, and advance both accordingly */
+    bool _write_out_chunks(const struct chunk *chunks, unsigned int count,
+                           unsigned int *idx, uint32_t *offset, uint32_t amount) {
+        while(amount > 0) {
+            MBED_ASSERT(*idx < count);
+
+            uint32_t to_write = chunks[*idx].len - *offset;
+            if(to_write > amount) to_write = amount;
+
+            if((to_write > 0) &&
+                    (_parser.write(chunks[*idx].buffer + *offset, (int)to_write) != (int)to_write)) {
+                return false;
+            }
+
+            amount -= to_write;
+            *offset += to_write;
+            if(*offset == chunks[*idx].len) {
+                (*idx)++;
+                *offset = 0;
+            }
+        }
+
+        return true;
+    }
 
     bool _recv_delim_lf(void) {
         return (_parser.getc() == _lf_);
@@ -347,13 +917,63 @@ private:
         return _recv_delim_cr() && _recv_delim_lf();
     }
 
-    bool _recv_ok(void) {
-        return _parser.recv(SPWFXX_RECV_OK) && _recv_delim_lf();
+    bool _send_cmd(const char *command, ...);
+
+    bool _recv_ok(void);
+
+    /* protocol engine (tokenizes received lines into typed events) */
+    SpwfProtocolEngine _engine;
+
+    SpwfProtocolEngine::event_t _recv_event(void);
+    SpwfProtocolEngine::event_t _recv_event_until(Timer &timer, uint32_t deadline_ms);
+    void _dispatch_event(SpwfProtocolEngine::event_t evt);
+    void _dispatch_wind(void);
+
+    void _recv_oob_line(const char *prefix) {
+        _engine.begin(prefix);
+        _dispatch_event(_recv_event());
     }
 
+    void _wind_oob_handler(void) {
+        _recv_oob_line(SPWF_PROTOCOL_WIND_PREFIX);
+    }
+
+    /* the module is not going to send the reply a pending `recv()` is waiting for */
+    void _error_oob_handler(void) {
+        _recv_oob_line(SPWFXX_OOB_ERROR);
+        _parser.abort();
+    }
+
+#if SPWFSA_TRACE_SIZE > 0
+    spwfsa_trace_event_t _trace_buf[SPWFSA_TRACE_SIZE];
+    volatile uint32_t _trace_wr;
+    uint32_t _trace_rd;
+
+    /* lock-free (might also be called in IRQ context) */
+    void _trace(spwfsa_trace_id_t event, int spwf_id, int32_t arg0, int32_t arg1) {
+        uint32_t idx = core_util_atomic_incr_u32(&_trace_wr, 1) - 1;
+        spwfsa_trace_event_t &e = _trace_buf[idx & (SPWFSA_TRACE_SIZE - 1)];
+
+        e.timestamp = us_ticker_read();
+        e.event = (uint8_t)event;
+        e.spwf_id = (int8_t)spwf_id;
+        e.arg0 = arg0;
+        e.arg1 = arg1;
+    }
+#endif // SPWFSA_TRACE_SIZE > 0
+
+#if SPWFSA_AT_LATENCY_STATS
+    spwfsa_at_latency_t _at_latency[SPWFSA_AT_CLASS_COUNT];
+    int _at_latency_class; // class of command currently being measured (`-1` for none)
+    uint32_t _at_latency_start_us;
+
+    void _at_latency_start(const char *command);
+    void _at_latency_stop(void);
+#endif // SPWFSA_AT_LATENCY_STATS
+
     void _add_pending_packet_sz(int spwf_id, uint32_t size);
-    void _add_pending_pkt_size(int spwf_id, uint32_t size) {
-        _pending_pkt_sizes[spwf_id].add(size);
+    bool _add_pending_pkt_size(int spwf_id, uint32_t size) {
+        return _pending_pkt_sizes[spwf_id].add(size);
     }
 
     uint32_t _get_cumulative_size(int spwf_id) {
@@ -364,14 +984,49 @@ private:
         return _pending_pkt_sizes[spwf_id].remove(size);
     }
 
+    /* remove (overall `size` bytes of) pending packet sizes */
+    void _remove_pending_pkt_sizes(int spwf_id, uint32_t size) {
+        while(size > 0) {
+            uint32_t next = _get_pending_pkt_size(spwf_id);
+
+            MBED_ASSERT((next > 0) && (next <= size));
+            if(next == 0) break;
+
+            size -= _remove_pending_pkt_size(spwf_id, next);
+        }
+    }
+
     uint32_t _get_pending_pkt_size(int spwf_id) {
         return _pending_pkt_sizes[spwf_id].get();
     }
 
+    uint32_t _get_pending_pkt_size(int spwf_id, unsigned int idx) {
+        return _pending_pkt_sizes[spwf_id].get(idx);
+    }
+
    void _reset_pending_pkt_sizes(int spwf_id) {
         _pending_pkt_sizes[spwf_id].reset();
     }
 
+    void _enqueue_packet(struct packet *packet) {
+        packet->next = 0;
+        *_packets_end[packet->id] = packet;
+        _packets_end[packet->id] = &packet->next;
+    }
+
+    struct packet *_dequeue_packet(int spwf_id) {
+        struct packet *packet = _packets[spwf_id];
+
+        if(packet != 0) {
+            _packets[spwf_id] = packet->next;
+            if(_packets[spwf_id] == 0) {
+                _packets_end[spwf_id] = &_packets[spwf_id];
+            }
+        }
+
+        return packet;
+    }
+
    void _set_pending_data(int spwf_id) {
        _pending_sockets_bitmap |= (1 << spwf_id);
    }
@@ -434,6 +1089,57 @@ private:
     char _gateway_buffer[16];
     char _netmask_buffer[16];
     char _mac_buffer[18];
+    int8_t _rssi;
+
+    /* network parameter cache (values are held in the buffers above) */
+    static const uint32_t _cache_timeouts[SPWFSA_CACHE_COUNT];
+    uint64_t _cache_stamps[SPWFSA_CACHE_COUNT]; // in us
+    volatile uint32_t _cache_valid_bitmap; // also read without driver (UART) lock
+
+    /* free running time base in us for long living stamps
+     * (Note: unlike a running `Timer` reading the us ticker does not hold the deep sleep lock) */
+    static uint64_t _ticker_us(void) {
+        return ticker_read_us(get_us_ticker_data());
+    }
+
+#if MBED_CONF_RTOS_PRESENT
+    /* protects cached values & stamps against `_cache_read()` (taken inside the driver (UART) lock) */
+    Mutex _cache_mutex;
+#endif
+
+    bool _cache_read(spwfsa_cache_field_t field, void *value);
+
+    bool _cache_is_fresh(spwfsa_cache_field_t field) {
+        if(!(_cache_valid_bitmap & (1 << field))) return false;
+        if(_cache_timeouts[field] == SPWFSA_CACHE_NO_TIMEOUT) return true;
+        return ((_ticker_us() - _cache_stamps[field]) < (_cache_timeouts[field] * 1000ULL));
+    }
+
+    void _cache_update(spwfsa_cache_field_t field) {
+        _cache_stamps[field] = _ticker_us();
+        _cache_valid_bitmap |= (1 << field);
+    }
+
+    /* invalidate all values depending on the network connection */
+    void _cache_invalidate_net(void) {
+        _cache_valid_bitmap &= (1 << SPWFSA_CACHE_MAC);
+    }
+
+    bool _update_ip_from_wifi_up(const char *line);
+
+    /* credentials stored in the module configuration (valid only if `_cfg_valid`) */
+    char _cfg_ssid[33];
+    char _cfg_pass[65];
+    int _cfg_sec_mode;
+    bool _cfg_valid;
+    bool _radio_off; // radio has been switched off by fast disconnect
+    spwfsa_connect_timing_t _connect_timing;
+    Timer _connect_timer;
+    uint32_t _startup_ms; // duration of last `startup()` not yet accounted to a connect
+
+    /* association state machine (driven by `+WIND:24` & `+WIND:40`) */
+    volatile spwfsa_assoc_state_t _assoc_state;
+    int _assoc_deauths;
 
     char _msg_buffer[256];
 
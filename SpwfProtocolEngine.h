@@ -0,0 +1,139 @@
+/* SPWFSAxx Devices
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#ifndef SPWF_PROTOCOL_ENGINE_H
+#define SPWF_PROTOCOL_ENGINE_H
+
+#include "mbed.h"
+
+#define SPWF_PROTOCOL_LINE_SIZE     (256)
+#define SPWF_PROTOCOL_WIND_PREFIX   "+WIND:"
+
+/* Incremental tokenizer for the byte stream received from SPWF modules
+ *
+ * Gets fed one byte at a time (never blocks) and turns each complete line into a typed event.
+ * The dialect specific parts (i.e. `OK` line & `ERROR` prefix) are passed to the constructor.
+ * Texts returned by the getters stay valid only until the next call to `feed()` or `begin()`.
+ */
+class SpwfProtocolEngine {
+public:
+    typedef enum {
+        EVT_NONE = 0,   // no complete line yet (or empty line)
+        EVT_OK,         // command completed successfully
+        EVT_ERROR,      // command failed, `text()` holds error description
+        EVT_WIND,       // asynchronous indication, see `wind_code()`, `text()` & `args()`
+        EVT_REPLY       // any other line (e.g. command reply), `text()` holds whole line
+    } event_t;
+
+    SpwfProtocolEngine(const char *ok_line, const char *error_prefix) :
+        _ok_line(ok_line), _error_prefix(error_prefix), _error_prefix_len(strlen(error_prefix)) {
+        reset();
+    }
+
+    /* drop (partially) received line */
+    void reset(void) {
+        _len = 0;
+        _wind_code = -1;
+        _text = _args = _line;
+        _line[0] = '\0';
+    }
+
+    /* start new line with (already consumed) `prefix` */
+    void begin(const char *prefix) {
+        reset();
+        while((*prefix != '\0') && (_len < (sizeof(_line) - 1))) {
+            _line[_len++] = *prefix++;
+        }
+    }
+
+    /* a line has been started but not yet completed */
+    bool in_line(void) const {
+        return (_len > 0);
+    }
+
+    event_t feed(int c) {
+        if(c == '\n') return EVT_NONE; // second line delimiter (or empty line)
+
+        if(c != '\r') {
+            if(_len < (sizeof(_line) - 1)) { // truncate overlong lines
+                _line[_len++] = (char)c;
+            }
+            return EVT_NONE;
+        }
+
+        /* end of line */
+        if(_len == 0) return EVT_NONE;
+
+        _line[_len] = '\0';
+        _len = 0;
+        return _classify();
+    }
+
+    const char *line(void) const { return _line; }
+    const char *text(void) const { return _text; }
+    const char *args(void) const { return _args; }  // indication arguments (i.e. after name) incl. leading ':'
+    int wind_code(void) const { return _wind_code; }
+
+private:
+    event_t _classify(void) {
+        _wind_code = -1;
+        _text = _args = _line;
+
+        if(strcmp(_line, _ok_line) == 0) {
+            return EVT_OK;
+        }
+
+        if(strncmp(_line, _error_prefix, _error_prefix_len) == 0) {
+            _text = &_line[_error_prefix_len];
+            return EVT_ERROR;
+        }
+
+        if(strncmp(_line, SPWF_PROTOCOL_WIND_PREFIX, sizeof(SPWF_PROTOCOL_WIND_PREFIX) - 1) == 0) {
+            char *p = &_line[sizeof(SPWF_PROTOCOL_WIND_PREFIX) - 1];
+            int code = 0;
+
+            if((*p < '0') || (*p > '9')) return EVT_REPLY;
+            while((*p >= '0') && (*p <= '9')) {
+                code = (code * 10) + (*p++ - '0');
+            }
+            if(*p == ':') p++;
+
+            _wind_code = code;
+            _text = p;
+
+            /* skip indication name */
+            while((*p != ':') && (*p != '\0')) p++;
+            _args = p;
+
+            return EVT_WIND;
+        }
+
+        return EVT_REPLY;
+    }
+
+    const char *_ok_line;
+    const char *_error_prefix;
+    size_t _error_prefix_len;
+
+    char _line[SPWF_PROTOCOL_LINE_SIZE];
+    size_t _len;
+
+    int _wind_code;
+    const char *_text;
+    const char *_args;
+};
+
+#endif // SPWF_PROTOCOL_ENGINE_H
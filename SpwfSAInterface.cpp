@@ -48,7 +48,17 @@ SpwfSAInterface::SpwfSAInterface(PinName tx, PinName rx,
                                  PinName rts, PinName cts, bool debug,
                                  PinName wakeup, PinName reset)
 : _spwf(tx, rx, rts, cts, *this, debug, wakeup, reset),
-  _dbg_on(debug)
+  _dbg_on(debug),
+  _conn_status(NSAPI_STATUS_DISCONNECTED),
+  _status_queue_head(0),
+  _status_queue_len(0),
+  _blocking(true)
+#if MBED_CONF_RTOS_PRESENT
+  , _worker_thread_started(false)
+#endif // MBED_CONF_RTOS_PRESENT
+#if SPWFSA_ASYNC_SEND
+  , _tx_thread_started(false)
+#endif // SPWFSA_ASYNC_SEND
 {
     inner_constructor();
     reset_credentials();
@@ -56,6 +66,17 @@ SpwfSAInterface::SpwfSAInterface(PinName tx, PinName rx,
 
 nsapi_error_t SpwfSAInterface::init(void)
 {
+#if MBED_CONF_RTOS_PRESENT
+    /* `_worker_thread` drives non-blocking association, network loss recovery, deferred closes
+     * & (with `SPWFSA_EVENT_THREAD`) UART event processing, so start it before talking to the module */
+    if(!_worker_thread_started) {
+        if(_worker_thread.start(Callback<void()>(this, &SpwfSAInterface::_worker_thread_loop)) != osOK) {
+            return NSAPI_ERROR_NO_MEMORY;
+        }
+        _worker_thread_started = true;
+    }
+#endif // MBED_CONF_RTOS_PRESENT
+
     _spwf.setTimeout(SPWF_INIT_TIMEOUT);
 
     if(_spwf.startup(0)) {
@@ -68,6 +89,10 @@ nsapi_error_t SpwfSAInterface::connect(void)
 {
     int mode;
     char *pass_phrase = ap_pass;
+#if !MBED_CONF_RTOS_PRESENT
+    /* no `_worker_thread`: report status changes on return */
+    BlockExecuter status_reporter(Callback<void()>(this, &SpwfSAInterface::_report_conn_status));
+#endif // !MBED_CONF_RTOS_PRESENT
     SYNC_HANDLER;
 
     // check for valid SSID
@@ -93,9 +118,9 @@ nsapi_error_t SpwfSAInterface::connect(void)
             break;
     }
 
-    // First: disconnect
-    if(_connected_to_network) {
-        if(!disconnect()) {
+    // First: disconnect (or abort pending association)
+    if(_connected_to_network || _spwf._assoc_pending()) {
+        if(disconnect() != NSAPI_ERROR_OK) {
             return NSAPI_ERROR_DEVICE_ERROR;
         }
     }
@@ -109,19 +134,131 @@ nsapi_error_t SpwfSAInterface::connect(void)
 
     // Then: (re-)connect
     _spwf.setTimeout(SPWF_CONNECT_TIMEOUT);
+    _set_conn_status(NSAPI_STATUS_CONNECTING);
+
+#if MBED_CONF_RTOS_PRESENT
+    if(!_blocking) {
+        if (!_spwf.connectStart(ap_ssid, pass_phrase, mode)) {
+            _set_conn_status(NSAPI_STATUS_DISCONNECTED);
+            return NSAPI_ERROR_AUTH_FAILURE;
+        }
+
+        /* let `_worker_thread` wait for `+WIND:24` */
+        _worker_sem.release();
+        return NSAPI_ERROR_OK;
+    }
+#endif // MBED_CONF_RTOS_PRESENT
 
     if (!_spwf.connect(ap_ssid, pass_phrase, mode)) {
+        _set_conn_status(NSAPI_STATUS_DISCONNECTED);
         return NSAPI_ERROR_AUTH_FAILURE;
     }
 
     if (!_spwf.getIPAddress()) {
+        _set_conn_status(NSAPI_STATUS_DISCONNECTED);
         return NSAPI_ERROR_DHCP_FAILURE;
     }
 
     _connected_to_network = true;
+    _set_conn_status(NSAPI_STATUS_GLOBAL_UP);
     return NSAPI_ERROR_OK;
 }
 
+#if MBED_CONF_RTOS_PRESENT
+/* Driver worker thread processing asynchronous indications during non-blocking association
+ * & network loss recovery, and draining & closing deferred closed sockets
+ * (with `SPWFSA_EVENT_THREAD` it also takes over the UART event processing from IRQ context) */
+void SpwfSAInterface::_worker_thread_loop(void)
+{
+    bool closing = false;
+    bool polling = false;
+    uint32_t sample_in = osWaitForever; // time until next RSSI sample
+    uint32_t restore_in = osWaitForever; // time until held WINDs get switched on again
+#if SPWFSA_RSSI_SAMPLE_PERIOD > 0
+    uint64_t rssi_stamp = SPWFSAxx::_ticker_us(); // last RSSI sample (or connect) in us
+#endif // SPWFSA_RSSI_SAMPLE_PERIOD > 0
+
+    while(true) {
+        bool uart_event = false;
+        uint32_t timeout = closing ? 0 : (polling ? SPWF_ASSOC_POLL_PERIOD : osWaitForever);
+
+        /* woken up by `event()`, `socket_close()` resp. UART IRQ, polling only while association is pending
+         * (continue immediately while sockets are being closed, releasing the driver lock in between) */
+        if(sample_in < timeout) timeout = sample_in;
+        if(restore_in < timeout) timeout = restore_in;
+        _worker_sem.wait(timeout);
+
+        {
+            SYNC_HANDLER;
+
+#if SPWFSA_EVENT_THREAD
+            if(_spwf._take_irq_events()) {
+                uart_event = true;
+
+                /* handle asynchronous indications & prefetch pending data */
+                _spwf.setTimeout(SPWF_MISC_TIMEOUT);
+                _spwf._process_winds();
+                _spwf._execute_bottom_halves();
+            }
+#endif // SPWFSA_EVENT_THREAD
+
+#if SPWFSA_TX_COALESCING
+            /* send out coalesced data once flush deadline has expired */
+            _tx_flush_expired();
+#endif // SPWFSA_TX_COALESCING
+
+            _spwf.setTimeout(SPWF_CLOSE_TIMEOUT);
+            closing = _spwf.processDeferredCloses();
+
+            if(_spwf._network_lost_flag) {
+                _spwf._network_lost_handler_bh();
+            } else if(_spwf._assoc_pending()) {
+                _spwf.setTimeout(SPWF_MISC_TIMEOUT);
+                if(_spwf.pollAssociation() == SPWFSA_ASSOC_UP) {
+                    _connected_to_network = true;
+                } else if(_spwf._assoc_pending() && (_spwf._connect_timer.read_ms() > SPWF_CONNECT_TIMEOUT)) {
+                    debug_if(_dbg_on, "\r\nSPWF> association timed out\r\n");
+                    _spwf.setTimeout(SPWF_DISCONNECT_TIMEOUT);
+                    _spwf.disconnect();
+                }
+            }
+
+#if SPWFSA_RSSI_SAMPLE_PERIOD > 0
+            /* keep RSSI cache up to date in the background while connected */
+            if(_connected_to_network) {
+                uint32_t elapsed_ms = (uint32_t)((SPWFSAxx::_ticker_us() - rssi_stamp) / 1000);
+
+                if(elapsed_ms >= SPWFSA_RSSI_SAMPLE_PERIOD) {
+                    _spwf.setTimeout(SPWF_MISC_TIMEOUT);
+                    _spwf.getRssi(true);
+                    rssi_stamp = SPWFSAxx::_ticker_us();
+                    elapsed_ms = 0;
+                }
+                sample_in = SPWFSA_RSSI_SAMPLE_PERIOD - elapsed_ms;
+            } else {
+                rssi_stamp = SPWFSAxx::_ticker_us();
+                sample_in = osWaitForever;
+            }
+#endif // SPWFSA_RSSI_SAMPLE_PERIOD > 0
+
+            /* switch WINDs on again once the application has stopped reading (see `SPWFSAxx::_winds_hold()`) */
+            restore_in = _spwf._winds_check_hold();
+
+            polling = (_spwf._network_lost_flag || _spwf._assoc_pending());
+            _set_conn_status(_get_conn_status());
+        }
+
+        /* report status changes (of all contexts) outside of driver lock */
+        _report_conn_status();
+
+        /* signal sockets (from thread instead of IRQ context) */
+        if(uart_event) {
+            event();
+        }
+    }
+}
+#endif // MBED_CONF_RTOS_PRESENT
+
 nsapi_error_t SpwfSAInterface::connect(const char *ssid, const char *pass, nsapi_security_t security,
                                        uint8_t channel)
 {
@@ -140,10 +277,16 @@ nsapi_error_t SpwfSAInterface::connect(const char *ssid, const char *pass, nsapi
 
 nsapi_error_t SpwfSAInterface::disconnect(void)
 {
+#if !MBED_CONF_RTOS_PRESENT
+    /* no `_worker_thread`: report status changes on return */
+    BlockExecuter status_reporter(Callback<void()>(this, &SpwfSAInterface::_report_conn_status));
+#endif // !MBED_CONF_RTOS_PRESENT
     SYNC_HANDLER;
 
     _spwf.setTimeout(SPWF_DISCONNECT_TIMEOUT);
-    CHECK_NOT_CONNECTED_ERR();
+    if(!_spwf._assoc_pending()) { // not connecting resp. recovering from network loss
+        CHECK_NOT_CONNECTED_ERR();
+    }
 
     if (!_spwf.disconnect()) {
         return NSAPI_ERROR_DEVICE_ERROR;
@@ -152,8 +295,112 @@ nsapi_error_t SpwfSAInterface::disconnect(void)
     return NSAPI_ERROR_OK;
 }
 
+void SpwfSAInterface::attach(Callback<void(nsapi_event_t, intptr_t)> status_cb)
+{
+    SYNC_HANDLER;
+
+    _status_cb = status_cb;
+}
+
+nsapi_connection_status_t SpwfSAInterface::get_connection_status() const
+{
+    return _conn_status;
+}
+
+nsapi_error_t SpwfSAInterface::set_blocking(bool blocking)
+{
+#if MBED_CONF_RTOS_PRESENT
+    SYNC_HANDLER;
+
+    _blocking = blocking;
+    return NSAPI_ERROR_OK;
+#else
+    if(!blocking) return NSAPI_ERROR_UNSUPPORTED;
+    return NSAPI_ERROR_OK;
+#endif
+}
+
+/* Connection status derived from driver state */
+nsapi_connection_status_t SpwfSAInterface::_get_conn_status(void)
+{
+    if(_connected_to_network) return NSAPI_STATUS_GLOBAL_UP;
+
+    switch(_spwf._assoc_state) {
+        case SPWFSA_ASSOC_ONGOING:
+            return NSAPI_STATUS_CONNECTING;
+        case SPWFSA_ASSOC_LINK_UP:
+            return NSAPI_STATUS_LOCAL_UP;
+        default:
+            return NSAPI_STATUS_DISCONNECTED;
+    }
+}
+
+/* Return if connected to network (without blocking) */
+bool SpwfSAInterface::_check_connected(void)
+{
+#if !MBED_CONF_RTOS_PRESENT
+    /* no `_worker_thread`: advance network loss recovery (if ongoing) here */
+    if(!_connected_to_network && _spwf._network_lost_flag) {
+        _spwf._network_lost_handler_bh();
+        _set_conn_status(_get_conn_status());
+        _report_conn_status();
+    }
+#endif // !MBED_CONF_RTOS_PRESENT
+
+    return _connected_to_network;
+}
+
+/* Note: to be called with driver lock held, `_status_cb` gets called later by `_report_conn_status()` */
+void SpwfSAInterface::_set_conn_status(nsapi_connection_status_t status)
+{
+    if(_conn_status == status) return;
+
+    _conn_status = status;
+
+    if(_status_queue_len == SPWFSA_STATUS_QUEUE_SIZE) { // drop oldest change
+        _status_queue_head = (_status_queue_head + 1) % SPWFSA_STATUS_QUEUE_SIZE;
+        _status_queue_len--;
+    }
+    _status_queue[(_status_queue_head + _status_queue_len) % SPWFSA_STATUS_QUEUE_SIZE] = status;
+    _status_queue_len++;
+
+#if MBED_CONF_RTOS_PRESENT
+    /* let `_worker_thread` report it */
+    _worker_sem.release();
+#endif // MBED_CONF_RTOS_PRESENT
+}
+
+/* Report queued status changes to `_status_cb` in order & outside of driver lock
+ * (with the RTOS present only called by `_worker_thread`, otherwise on return of `connect()` & `disconnect()`
+ *  resp. by the next socket call) */
+void SpwfSAInterface::_report_conn_status(void)
+{
+    while(true) {
+        nsapi_connection_status_t status;
+        Callback<void(nsapi_event_t, intptr_t)> status_cb;
+
+        {
+            SYNC_HANDLER;
+
+            if(_status_queue_len == 0) return;
+
+            status = _status_queue[_status_queue_head];
+            _status_queue_head = (_status_queue_head + 1) % SPWFSA_STATUS_QUEUE_SIZE;
+            _status_queue_len--;
+            status_cb = _status_cb;
+        }
+
+        if(status_cb) {
+            status_cb(NSAPI_EVENT_CONNECTION_STATUS_CHANGE, status);
+        }
+    }
+}
+
 const char *SpwfSAInterface::get_ip_address(void)
 {
+    /* serve cached value without taking the driver (UART) lock */
+    if(_spwf._cache_read(SPWFSA_CACHE_IP, _cached_ip)) return _cached_ip;
+
     SYNC_HANDLER;
 
     _spwf.setTimeout(SPWF_MISC_TIMEOUT);
@@ -162,6 +409,9 @@ const char *SpwfSAInterface::get_ip_address(void)
 
 const char *SpwfSAInterface::get_mac_address(void)
 {
+    /* serve cached value without taking the driver (UART) lock */
+    if(_spwf._cache_read(SPWFSA_CACHE_MAC, _cached_mac)) return _cached_mac;
+
     SYNC_HANDLER;
 
     _spwf.setTimeout(SPWF_MISC_TIMEOUT);
@@ -170,6 +420,11 @@ const char *SpwfSAInterface::get_mac_address(void)
 
 const char *SpwfSAInterface::get_gateway(void)
 {
+    if(!_connected_to_network) return NULL;
+
+    /* serve cached value without taking the driver (UART) lock */
+    if(_spwf._cache_read(SPWFSA_CACHE_GATEWAY, _cached_gateway)) return _cached_gateway;
+
     SYNC_HANDLER;
 
     if(!_connected_to_network) return NULL;
@@ -180,6 +435,11 @@ const char *SpwfSAInterface::get_gateway(void)
 
 const char *SpwfSAInterface::get_netmask(void)
 {
+    if(!_connected_to_network) return NULL;
+
+    /* serve cached value without taking the driver (UART) lock */
+    if(_spwf._cache_read(SPWFSA_CACHE_NETMASK, _cached_netmask)) return _cached_netmask;
+
     SYNC_HANDLER;
 
     if(!_connected_to_network) return NULL;
@@ -210,6 +470,22 @@ nsapi_error_t SpwfSAInterface::socket_open(void **handle, nsapi_protocol_t proto
     socket->proto = proto;
     socket->addr = SocketAddress();
 
+#if SPWFSA_TX_COALESCING
+    _tx_bufs[internal_id].enabled = false;
+    _tx_bufs[internal_id].err = NSAPI_ERROR_OK;
+    _tx_bufs[internal_id].len = 0;
+#endif // SPWFSA_TX_COALESCING
+
+#if SPWFSA_ASYNC_SEND
+    {
+        ScopedMutexLock tx_sync_handler(_tx_mutex);
+        _tx_rings[internal_id].enabled = false;
+        _tx_rings[internal_id].err = NSAPI_ERROR_OK;
+        _tx_rings[internal_id].start = 0;
+        _tx_rings[internal_id].len = 0;
+    }
+#endif // SPWFSA_ASYNC_SEND
+
     *handle = socket;
     return NSAPI_ERROR_OK;
 }
@@ -291,10 +567,27 @@ nsapi_error_t SpwfSAInterface::socket_close(void *handle)
     if(!_socket_is_open(internal_id)) return NSAPI_ERROR_NO_SOCKET;
 
     if(_socket_has_connected(socket)) {
+#if SPWFSA_TX_COALESCING
+        _tx_flush_expired();
+        if(_socket_tx_flush(socket) < 0) { // try to send out coalesced data before closing
+            debug_if(_dbg_on, "\r\nSPWF> %s: dropping %u coalesced bytes\r\n", __func__, _tx_bufs[internal_id].len);
+        }
+#endif // SPWFSA_TX_COALESCING
+
+#if SPWFSA_ASYNC_SEND
+        _socket_tx_drain(socket); // try to send out queued data before closing
+#endif // SPWFSA_ASYNC_SEND
+
+#if SPWFSA_ASYNC_CLOSE
+        /* let `_worker_thread` drain & close the module socket */
+        _spwf.closeDeferred(socket->spwf_id);
+        _worker_sem.release();
+#else // !SPWFSA_ASYNC_CLOSE
         _spwf.setTimeout(SPWF_CLOSE_TIMEOUT);
         if (!_spwf.close(socket->spwf_id)) {
             return NSAPI_ERROR_DEVICE_ERROR;
         }
+#endif // !SPWFSA_ASYNC_CLOSE
         _internal_ids[socket->spwf_id] = SPWFSA_SOCKET_COUNT;
     }
 
@@ -307,27 +600,308 @@ nsapi_error_t SpwfSAInterface::socket_close(void *handle)
 nsapi_size_or_error_t SpwfSAInterface::socket_send(void *handle, const void *data, unsigned size)
 {
     spwf_socket_t *socket = (spwf_socket_t*)handle;
+
+#if SPWFSA_ASYNC_SEND
+    {
+        bool async;
+        nsapi_size_or_error_t ret = _socket_send_async(socket, data, size, &async); // does not need to take `_spwf_mutex`
+        if(async) return ret;
+    }
+#endif // SPWFSA_ASYNC_SEND
+
     SYNC_HANDLER;
 
     CHECK_NOT_CONNECTED_ERR();
 
+#if SPWFSA_TX_COALESCING
+    _tx_flush_expired();
+
+    if(_tx_bufs[socket->internal_id].err < 0) { // report error of previous flush on deadline
+        return _socket_tx_flush_err(socket->internal_id);
+    }
+
+    if(_socket_has_connected(socket) && _tx_bufs[socket->internal_id].enabled) {
+        return _socket_send_coalesced(socket, data, size);
+    }
+#endif // SPWFSA_TX_COALESCING
+
     _spwf.setTimeout(SPWF_SEND_TIMEOUT);
     return _spwf.send(socket->spwf_id, data, size, socket->internal_id);
 }
 
-nsapi_size_or_error_t SpwfSAInterface::socket_recv(void *handle, void *data, unsigned size)
+#if SPWFSA_TX_COALESCING
+nsapi_size_or_error_t SpwfSAInterface::_socket_send_coalesced(spwf_socket_t *socket, const void *data, unsigned size)
 {
-    SYNC_HANDLER;
+    nsapi_error_t err;
+    int internal_id = socket->internal_id;
+
+    /* data does not fit anymore: send out already coalesced data first */
+    if((_tx_bufs[internal_id].len + size) > sizeof(_tx_bufs[internal_id].data)) {
+        err = _socket_tx_flush(socket);
+        if(err < 0) return err;
+    }
+
+    /* data is too big to be coalesced at all: send it out directly */
+    if(size > sizeof(_tx_bufs[internal_id].data)) {
+        _spwf.setTimeout(SPWF_SEND_TIMEOUT);
+        return _spwf.send(socket->spwf_id, data, size, internal_id);
+    }
+
+    memcpy(&_tx_bufs[internal_id].data[_tx_bufs[internal_id].len], data, size);
+    _tx_bufs[internal_id].len += size;
+
+    if(_tx_bufs[internal_id].len == sizeof(_tx_bufs[internal_id].data)) { // buffer full
+        err = _socket_tx_flush(socket);
+        if(err < 0) { // data has been taken over, report error with next `socket_send()`
+            _tx_bufs[internal_id].err = err;
+        }
+    }
+
+    if((_tx_bufs[internal_id].len > 0) && !_tx_flush_armed) { // start flush deadline (also to retry unsent tail)
+        _tx_flush_armed = true;
+        _tx_flush_timeout.attach_us(Callback<void()>(this, &SpwfSAInterface::_tx_flush_timeout_handler),
+                                    SPWF_TX_FLUSH_TIMEOUT * 1000);
+    }
+
+    return size;
+}
+
+/* Note: in case of error (or partial write) the unsent tail of coalesced data is kept for the next flush */
+nsapi_error_t SpwfSAInterface::_socket_tx_flush(spwf_socket_t *socket)
+{
+    nsapi_size_or_error_t ret;
+    int internal_id = socket->internal_id;
+    uint16_t len = _tx_bufs[internal_id].len;
+
+    if(len == 0) return NSAPI_ERROR_OK;
+
+    _spwf.setTimeout(SPWF_SEND_TIMEOUT);
+    ret = _spwf.send(socket->spwf_id, _tx_bufs[internal_id].data, len, internal_id);
+    if(ret < 0) {
+        debug_if(_dbg_on, "\r\nSPWF> %s failed (%d)\r\n", __func__, ret);
+        return ret;
+    }
+
+    _tx_bufs[internal_id].len = len - ret;
+    if(ret != len) {
+        debug_if(_dbg_on, "\r\nSPWF> %s sent only %d of %u bytes\r\n", __func__, ret, len);
+        memmove(&_tx_bufs[internal_id].data[0], &_tx_bufs[internal_id].data[ret], len - ret);
+        return NSAPI_ERROR_DEVICE_ERROR;
+    }
+
+    return NSAPI_ERROR_OK;
+}
+
+/* Send out coalesced data of all sockets once flush deadline has expired
+ * (errors get latched & reported by the next `socket_send()`) */
+void SpwfSAInterface::_tx_flush_expired(void)
+{
+    if(!_tx_flush_due) return;
+    _tx_flush_due = false;
+
+    for (int internal_id = 0; internal_id < SPWFSA_SOCKET_COUNT; internal_id++) {
+        if(_socket_has_connected(internal_id)) {
+            nsapi_error_t err = _socket_tx_flush(&_ids[internal_id]);
+            if(err < 0) {
+                _tx_bufs[internal_id].err = err;
+            }
+        }
+    }
+}
+
+/*
+ * Flush deadline handler
+ *
+ * Note: executed in IRQ context!
+ * Note: flushing itself is deferred to the driver worker thread (RTOS present),
+ *       resp. to the next socket call, which gets triggered by calling the socket callbacks
+ */
+void SpwfSAInterface::_tx_flush_timeout_handler(void)
+{
+    _tx_flush_due = true;
+
+#if MBED_CONF_RTOS_PRESENT
+    if(_worker_thread_started) {
+        _tx_flush_armed = false;
+        _worker_sem.release();
+        return;
+    }
+#endif // MBED_CONF_RTOS_PRESENT
+
+    if(_spwf._is_event_callback_blocked()) { // do not call (external) callback, retry later
+        _tx_flush_timeout.attach_us(Callback<void()>(this, &SpwfSAInterface::_tx_flush_timeout_handler),
+                                    SPWF_TX_FLUSH_TIMEOUT * 1000);
+        return;
+    }
+
+    _tx_flush_armed = false;
+    event();
+}
+#endif // SPWFSA_TX_COALESCING
+
+#if SPWFSA_ASYNC_SEND
+/*
+ * Queue data into the socket's TX ring, which gets drained by the driver worker thread
+ *
+ * Note: returns `NSAPI_ERROR_WOULD_BLOCK` if the ring is full, the socket gets signaled once there is space again
+ * Note: sets `*async` to false (without queuing anything) if asynchronous sending is disabled for the socket,
+ *       as `enabled` is checked under `_tx_mutex` no data can be queued after `setsockopt()` has drained the ring
+ */
+nsapi_size_or_error_t SpwfSAInterface::_socket_send_async(spwf_socket_t *socket, const void *data, unsigned size, bool *async)
+{
+    nsapi_error_t err;
+    int internal_id = socket->internal_id;
+    unsigned int space, end, first;
+
+    *async = true;
+
+    CHECK_NOT_CONNECTED_ERR();
+    if(!_socket_is_still_connected(socket)) {
+        return NSAPI_ERROR_CONNECTION_LOST;
+    }
+
+    {
+        ScopedMutexLock tx_sync_handler(_tx_mutex);
+
+        if(!_tx_rings[internal_id].enabled) {
+            *async = false;
+            return 0;
+        }
+
+        if(size == 0) return 0;
+
+        if(_tx_rings[internal_id].err < 0) { // report error of previous asynchronous sending
+            err = _tx_rings[internal_id].err;
+            _tx_rings[internal_id].err = NSAPI_ERROR_OK;
+            return err;
+        }
+
+        space = sizeof(_tx_rings[internal_id].data) - _tx_rings[internal_id].len;
+        if(space == 0) return NSAPI_ERROR_WOULD_BLOCK;
+        if(size > space) size = space;
+
+        end = (_tx_rings[internal_id].start + _tx_rings[internal_id].len) % sizeof(_tx_rings[internal_id].data);
+        first = sizeof(_tx_rings[internal_id].data) - end;
+        if(first > size) first = size;
+
+        memcpy(&_tx_rings[internal_id].data[end], data, first);
+        memcpy(&_tx_rings[internal_id].data[0], ((const uint8_t*)data) + first, size - first);
+        _tx_rings[internal_id].len += size;
+    }
+
+    _tx_sem.release();
+    return size;
+}
+
+/*
+ * Send out all data queued in the socket's TX ring
+ *
+ * Note: to be called with `_spwf_mutex` locked
+ * Note: queued data gets dropped in case of error, the error is reported by the next `socket_send()`
+ * Note: returns true if space has been freed in the TX ring or an error has been latched
+ */
+bool SpwfSAInterface::_socket_tx_drain(spwf_socket_t *socket)
+{
+    nsapi_size_or_error_t ret;
+    bool progress = false;
+    int internal_id = socket->internal_id;
+    uint8_t *chunk;
+    unsigned int len;
+
+    while(true) {
+        {
+            ScopedMutexLock tx_sync_handler(_tx_mutex);
+
+            /* send contiguous part of ring (which is not touched by `_socket_send_async()`) */
+            chunk = &_tx_rings[internal_id].data[_tx_rings[internal_id].start];
+            len = sizeof(_tx_rings[internal_id].data) - _tx_rings[internal_id].start;
+            if(len > _tx_rings[internal_id].len) len = _tx_rings[internal_id].len;
+            if(len > SPWFXX_SEND_RECV_PKTSIZE) len = SPWFXX_SEND_RECV_PKTSIZE;
+        }
+
+        if(len == 0) return progress;
+
+        _spwf.setTimeout(SPWF_SEND_TIMEOUT);
+        ret = _spwf.send(socket->spwf_id, chunk, len, internal_id);
 
+        {
+            ScopedMutexLock tx_sync_handler(_tx_mutex);
+
+            if(ret <= 0) {
+                debug_if(_dbg_on, "\r\nSPWF> %s failed (%d)\r\n", __func__, ret);
+                _tx_rings[internal_id].err = (ret < 0) ? ret : NSAPI_ERROR_DEVICE_ERROR;
+                _tx_rings[internal_id].start = 0;
+                _tx_rings[internal_id].len = 0;
+                return true;
+            }
+
+            _tx_rings[internal_id].start = (_tx_rings[internal_id].start + ret) % sizeof(_tx_rings[internal_id].data);
+            _tx_rings[internal_id].len -= ret;
+            progress = true;
+        }
+    }
+}
+
+/* Driver worker thread draining the TX rings of all sockets */
+void SpwfSAInterface::_tx_thread_loop(void)
+{
+    while(true) {
+        _tx_sem.wait();
+
+        for (int internal_id = 0; internal_id < SPWFSA_SOCKET_COUNT; internal_id++) {
+            bool signal;
+
+            {
+                SYNC_HANDLER;
+
+                if(!_connected_to_network || !_socket_has_connected(internal_id)
+                        || !_tx_rings[internal_id].enabled) {
+                    continue;
+                }
+
+                signal = _socket_tx_drain(&_ids[internal_id]);
+            }
+
+            /* signal space in TX ring (or error) only to sockets concerned */
+            if(signal) {
+                void (*callback)(void *);
+                void *data;
+
+                _get_socket_cb(internal_id, &callback, &data);
+                if (callback) {
+                    callback(data);
+                }
+            }
+        }
+    }
+}
+#endif // SPWFSA_ASYNC_SEND
+
+nsapi_size_or_error_t SpwfSAInterface::socket_recv(void *handle, void *data, unsigned size)
+{
     return _socket_recv(handle, data, size, false);
 }
 
+/* Note: takes the driver (UART) lock only if no data has been queued for `handle` yet */
 nsapi_size_or_error_t SpwfSAInterface::_socket_recv(void *handle, void *data, unsigned size, bool datagram)
 {
     spwf_socket_t *socket = (spwf_socket_t*)handle;
 
     CHECK_NOT_CONNECTED_ERR();
 
+    if(_socket_recv_queued_ok(socket)) {
+        int32_t recv = _spwf.recvQueued(socket->spwf_id, data, (uint32_t)size, datagram);
+        if(recv >= 0) return recv;
+    }
+
+    SYNC_HANDLER;
+
+    CHECK_NOT_CONNECTED_ERR();
+
+#if SPWFSA_TX_COALESCING
+    _tx_flush_expired();
+#endif // SPWFSA_TX_COALESCING
+
     if(!_socket_has_connected(socket)) {
         return NSAPI_ERROR_WOULD_BLOCK;
     } else if(socket->no_more_data) {
@@ -353,6 +927,125 @@ nsapi_size_or_error_t SpwfSAInterface::_socket_recv(void *handle, void *data, un
     return recv;
 }
 
+nsapi_size_or_error_t SpwfSAInterface::socket_sendv(nsapi_socket_t handle, const spwfsa_iovec_t *iov, unsigned int iovcnt)
+{
+    spwf_socket_t *socket = (spwf_socket_t*)handle;
+
+#if SPWFSA_ASYNC_SEND
+    { // queue buffers one after the other
+        bool async = true;
+        nsapi_size_or_error_t ret, total = 0;
+        unsigned int i;
+
+        for(i = 0; i < iovcnt; i++) {
+            ret = _socket_send_async(socket, iov[i].buffer, iov[i].len, &async);
+            if(!async) break; // asynchronous sending is (or has just been) disabled
+            if(ret < 0) return (total > 0) ? total : ret;
+
+            total += ret;
+            if((uint32_t)ret < iov[i].len) break; // TX ring is full
+        }
+        if(async || (total > 0)) return total;
+    }
+#endif // SPWFSA_ASYNC_SEND
+
+    SYNC_HANDLER;
+
+    CHECK_NOT_CONNECTED_ERR();
+
+#if SPWFSA_TX_COALESCING
+    _tx_flush_expired();
+
+    if(_tx_bufs[socket->internal_id].err < 0) { // report error of previous flush on deadline
+        return _socket_tx_flush_err(socket->internal_id);
+    }
+
+    if(_socket_has_connected(socket) && _tx_bufs[socket->internal_id].enabled) {
+        nsapi_error_t err = _socket_tx_flush(socket); // keep byte order
+        if(err < 0) return err;
+    }
+#endif // SPWFSA_TX_COALESCING
+
+    _spwf.setTimeout(SPWF_SEND_TIMEOUT);
+    return _spwf.sendv(socket->spwf_id, iov, iovcnt, socket->internal_id);
+}
+
+/* Note: takes the driver (UART) lock only if no data has been queued for `handle` yet */
+nsapi_size_or_error_t SpwfSAInterface::socket_recvv(nsapi_socket_t handle, spwfsa_iovec_t *iov, unsigned int iovcnt)
+{
+    spwf_socket_t *socket = (spwf_socket_t*)handle;
+
+    CHECK_NOT_CONNECTED_ERR();
+
+    if(_socket_recv_queued_ok(socket)) {
+        int32_t recv = _spwf.recvvQueued(socket->spwf_id, iov, iovcnt, (socket->proto == NSAPI_UDP));
+        if(recv >= 0) return recv;
+    }
+
+    SYNC_HANDLER;
+
+    CHECK_NOT_CONNECTED_ERR();
+
+#if SPWFSA_TX_COALESCING
+    _tx_flush_expired();
+#endif // SPWFSA_TX_COALESCING
+
+    if(!_socket_has_connected(socket)) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    } else if(socket->no_more_data) {
+        return 0;
+    }
+
+    _spwf.setTimeout(SPWF_RECV_TIMEOUT);
+
+    int32_t recv = _spwf.recvv(socket->spwf_id, iov, iovcnt, (socket->proto == NSAPI_UDP));
+
+    MBED_ASSERT(!_spwf._is_event_callback_blocked());
+
+    if (recv < 0) {
+        if(!_socket_is_still_connected(socket)) {
+            socket->no_more_data = true;
+            return 0;
+        }
+
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+
+    return recv;
+}
+
+nsapi_size_or_error_t SpwfSAInterface::socket_sendv(TCPSocket &socket, const spwfsa_iovec_t *iov, unsigned int iovcnt)
+{
+    nsapi_socket_t handle = _get_socket_handle(socket);
+    if(handle == NULL) return NSAPI_ERROR_NO_SOCKET;
+
+    return socket_sendv(handle, iov, iovcnt);
+}
+
+nsapi_size_or_error_t SpwfSAInterface::socket_sendv(UDPSocket &socket, const spwfsa_iovec_t *iov, unsigned int iovcnt)
+{
+    nsapi_socket_t handle = _get_socket_handle(socket);
+    if(handle == NULL) return NSAPI_ERROR_NO_SOCKET;
+
+    return socket_sendv(handle, iov, iovcnt);
+}
+
+nsapi_size_or_error_t SpwfSAInterface::socket_recvv(TCPSocket &socket, spwfsa_iovec_t *iov, unsigned int iovcnt)
+{
+    nsapi_socket_t handle = _get_socket_handle(socket);
+    if(handle == NULL) return NSAPI_ERROR_NO_SOCKET;
+
+    return socket_recvv(handle, iov, iovcnt);
+}
+
+nsapi_size_or_error_t SpwfSAInterface::socket_recvv(UDPSocket &socket, spwfsa_iovec_t *iov, unsigned int iovcnt)
+{
+    nsapi_socket_t handle = _get_socket_handle(socket);
+    if(handle == NULL) return NSAPI_ERROR_NO_SOCKET;
+
+    return socket_recvv(handle, iov, iovcnt);
+}
+
 nsapi_size_or_error_t SpwfSAInterface::socket_sendto(void *handle, const SocketAddress &addr, const void *data, unsigned size)
 {
     spwf_socket_t *socket = (spwf_socket_t*)handle;
@@ -361,10 +1054,16 @@ nsapi_size_or_error_t SpwfSAInterface::socket_sendto(void *handle, const SocketA
     CHECK_NOT_CONNECTED_ERR();
 
     if ((_socket_has_connected(socket)) && (socket->addr != addr)) {
+#if SPWFSA_ASYNC_CLOSE
+        /* let `_worker_thread` drain & close the module socket */
+        _spwf.closeDeferred(socket->spwf_id);
+        _worker_sem.release();
+#else // !SPWFSA_ASYNC_CLOSE
         _spwf.setTimeout(SPWF_CLOSE_TIMEOUT);
         if (!_spwf.close(socket->spwf_id)) {
             return NSAPI_ERROR_DEVICE_ERROR;
         }
+#endif // !SPWFSA_ASYNC_CLOSE
         _internal_ids[socket->spwf_id] = SPWFSA_SOCKET_COUNT;
         socket->spwf_id = SPWFSA_SOCKET_COUNT;
     }
@@ -384,7 +1083,6 @@ nsapi_size_or_error_t SpwfSAInterface::socket_recvfrom(void *handle, SocketAddre
 {
     spwf_socket_t *socket = (spwf_socket_t*)handle;
     nsapi_error_t ret;
-    SYNC_HANDLER;
 
     ret = _socket_recv(socket, data, size, true);
     if (ret >= 0 && addr) {
@@ -394,21 +1092,106 @@ nsapi_size_or_error_t SpwfSAInterface::socket_recvfrom(void *handle, SocketAddre
     return ret;
 }
 
+/* Note: does not take the driver (UART) lock, callbacks are read by `event()` (possibly in IRQ context) anyway */
 void SpwfSAInterface::socket_attach(void *handle, void (*callback)(void *), void *data)
 {
     spwf_socket_t *socket = (spwf_socket_t*)handle;
-    SYNC_HANDLER;
 
     if(!_socket_is_open(socket)) return; // might happen e.g. after module hard fault or voluntary disconnection
 
-    _cbs[socket->internal_id].callback = callback;
-    _cbs[socket->internal_id].data = data;
+    _set_socket_cb(socket->internal_id, callback, data);
+}
+
+nsapi_error_t SpwfSAInterface::setsockopt(nsapi_socket_t handle, int level, int optname, const void *optval, unsigned optlen)
+{
+    spwf_socket_t *socket = (spwf_socket_t*)handle;
+    SYNC_HANDLER;
+
+    if(level != SPWFSA_SOCKOPT_LEVEL) return NSAPI_ERROR_UNSUPPORTED;
+    if(!_socket_is_open(socket)) return NSAPI_ERROR_NO_SOCKET;
+
+    switch(optname) {
+#if SPWFSA_TX_COALESCING
+        case SPWFSA_SOCKOPT_TX_COALESCE:
+            if((optval == NULL) || (optlen != sizeof(int))) return NSAPI_ERROR_PARAMETER;
+            if(socket->proto != NSAPI_TCP) return NSAPI_ERROR_UNSUPPORTED; // would break datagram boundaries
+
+            if(*(const int*)optval != 0) {
+                _tx_bufs[socket->internal_id].enabled = true;
+                return NSAPI_ERROR_OK;
+            } else {
+                if(_socket_has_connected(socket)) {
+                    nsapi_error_t err = _socket_tx_flush(socket);
+                    if(err < 0) return err; // keep coalescing (& unsent data) until flushing succeeds
+                }
+                _tx_bufs[socket->internal_id].enabled = false;
+                return NSAPI_ERROR_OK;
+            }
+        case SPWFSA_SOCKOPT_TX_FLUSH:
+            CHECK_NOT_CONNECTED_ERR();
+            if(!_socket_has_connected(socket)) return NSAPI_ERROR_NO_CONNECTION;
+
+            _tx_flush_expired();
+            return _socket_tx_flush(socket);
+#endif // SPWFSA_TX_COALESCING
+#if SPWFSA_ASYNC_SEND
+        case SPWFSA_SOCKOPT_TX_ASYNC:
+            if((optval == NULL) || (optlen != sizeof(int))) return NSAPI_ERROR_PARAMETER;
+            if(socket->proto != NSAPI_TCP) return NSAPI_ERROR_UNSUPPORTED; // would break datagram boundaries
+
+            if(*(const int*)optval != 0) {
+                if(!_tx_thread_started) {
+                    if(_tx_thread.start(Callback<void()>(this, &SpwfSAInterface::_tx_thread_loop)) != osOK) {
+                        return NSAPI_ERROR_NO_MEMORY;
+                    }
+                    _tx_thread_started = true;
+                }
+#if SPWFSA_TX_COALESCING
+                if(_socket_has_connected(socket)) { // keep byte order
+                    _tx_flush_expired();
+
+                    nsapi_error_t err = _socket_tx_flush(socket);
+                    if(err < 0) return err;
+                }
+#endif // SPWFSA_TX_COALESCING
+                {
+                    ScopedMutexLock tx_sync_handler(_tx_mutex);
+                    _tx_rings[socket->internal_id].enabled = true;
+                }
+                return NSAPI_ERROR_OK;
+            } else {
+                {
+                    ScopedMutexLock tx_sync_handler(_tx_mutex);
+                    _tx_rings[socket->internal_id].enabled = false; // (later) `socket_send()`s wait for `_spwf_mutex`
+                }
+
+                /* drain only after clearing, `_socket_send_async()` cannot queue data anymore */
+                if(_socket_has_connected(socket)) {
+                    _socket_tx_drain(socket);
+                }
+                return NSAPI_ERROR_OK;
+            }
+#endif // SPWFSA_ASYNC_SEND
+        default:
+            return NSAPI_ERROR_UNSUPPORTED;
+    }
 }
 
 void SpwfSAInterface::event(void) {
+#if MBED_CONF_RTOS_PRESENT
+    /* new asynchronous indication(s) might be pending */
+    if(_spwf._assoc_pending()) {
+        _worker_sem.release();
+    }
+#endif // MBED_CONF_RTOS_PRESENT
+
     for (int internal_id = 0; internal_id < SPWFSA_SOCKET_COUNT; internal_id++) {
-        if (_cbs[internal_id].callback && (_ids[internal_id].internal_id != SPWFSA_SOCKET_COUNT)) {
-            _cbs[internal_id].callback(_cbs[internal_id].data);
+        void (*callback)(void *);
+        void *data;
+
+        _get_socket_cb(internal_id, &callback, &data);
+        if (callback && (_ids[internal_id].internal_id != SPWFSA_SOCKET_COUNT)) {
+            callback(data);
         }
     }
 }
@@ -449,6 +1232,12 @@ nsapi_error_t SpwfSAInterface::set_channel(uint8_t channel)
 
 int8_t SpwfSAInterface::get_rssi(void)
 {
+    if(!_connected_to_network) return 0;
+
+    /* serve cached value without taking the driver (UART) lock */
+    int8_t rssi;
+    if(_spwf._cache_read(SPWFSA_CACHE_RSSI, &rssi)) return rssi;
+
     SYNC_HANDLER;
 
     if(!_connected_to_network) return 0;
@@ -458,6 +1247,20 @@ int8_t SpwfSAInterface::get_rssi(void)
 }
 
 nsapi_size_or_error_t SpwfSAInterface::scan(WiFiAccessPoint *res, unsigned count)
+{
+    return _scan(res, count, spwfsa_scan_cb_t(), NULL);
+}
+
+nsapi_size_or_error_t SpwfSAInterface::scan_stream(spwfsa_scan_cb_t cb, const spwfsa_scan_filter_t *filter)
+{
+    if(!(bool)cb) return NSAPI_ERROR_PARAMETER;
+
+    return _scan(NULL, 0, cb, filter);
+}
+
+/* Note: in case `cb` is set results are streamed to it, otherwise stored into `res` */
+nsapi_size_or_error_t SpwfSAInterface::_scan(WiFiAccessPoint *res, unsigned count,
+                                             spwfsa_scan_cb_t cb, const spwfsa_scan_filter_t *filter)
 {
     SYNC_HANDLER;
 
@@ -469,6 +1272,14 @@ nsapi_size_or_error_t SpwfSAInterface::scan(WiFiAccessPoint *res, unsigned count
         if(init() != NSAPI_ERROR_OK) return NSAPI_ERROR_DEVICE_ERROR;
     }
 
+#if SPWFSA_FAST_RECONNECT
+    /* radio switched off by fast disconnect: complete disconnect (i.e. switch to idle mode) */
+    if(_spwf._radio_off) {
+        _spwf.setTimeout(SPWF_DISCONNECT_TIMEOUT);
+        if(!_spwf.disconnect()) return NSAPI_ERROR_DEVICE_ERROR;
+    }
+#endif // SPWFSA_FAST_RECONNECT
+
     _spwf.setTimeout(SPWF_SCAN_TIMEOUT);
 
     {
@@ -482,7 +1293,11 @@ nsapi_size_or_error_t SpwfSAInterface::scan(WiFiAccessPoint *res, unsigned count
             return NSAPI_ERROR_DEVICE_ERROR;
         }
 
-        ret = _spwf.scan(res, count);
+        if((bool)cb) {
+            ret = _spwf.scanStream(cb, filter);
+        } else {
+            ret = _spwf.scan(res, count);
+        }
 
         /* unblock asynchronous indications */
         _spwf._winds_on();
@@ -500,6 +1315,82 @@ nsapi_size_or_error_t SpwfSAInterface::scan(WiFiAccessPoint *res, unsigned count
     return ret;
 }
 
+void SpwfSAInterface::get_packet_pool_stats(unsigned int *max_used, unsigned int *exhausted)
+{
+    _spwf.getPacketPoolStats(max_used, exhausted);
+}
+
+void SpwfSAInterface::get_recv_stats(uint32_t *at_cmds, uint32_t *bytes)
+{
+    SYNC_HANDLER;
+
+    _spwf.getRecvStats(at_cmds, bytes);
+}
+
+void SpwfSAInterface::get_close_stats(spwfsa_close_stats_t *stats)
+{
+    SYNC_HANDLER;
+
+    _spwf.getCloseStats(stats);
+}
+
+void SpwfSAInterface::get_connect_timing(spwfsa_connect_timing_t *timing)
+{
+    SYNC_HANDLER;
+
+    _spwf.getConnectTiming(timing);
+}
+
+nsapi_error_t SpwfSAInterface::get_at_latency_stats(spwfsa_at_class_t cmd_class, spwfsa_at_latency_t *stats)
+{
+    SYNC_HANDLER;
+
+#if SPWFSA_AT_LATENCY_STATS
+    if(!_spwf.getAtLatencyStats(cmd_class, stats)) return NSAPI_ERROR_PARAMETER;
+    return NSAPI_ERROR_OK;
+#else // !SPWFSA_AT_LATENCY_STATS
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif // !SPWFSA_AT_LATENCY_STATS
+}
+
+void SpwfSAInterface::reset_at_latency_stats(void)
+{
+    SYNC_HANDLER;
+
+    _spwf.resetAtLatencyStats();
+}
+
+nsapi_size_or_error_t SpwfSAInterface::read_trace(spwfsa_trace_event_t *events, unsigned int count)
+{
+    SYNC_HANDLER;
+
+#if SPWFSA_TRACE_SIZE > 0
+    return _spwf.readTrace(events, count);
+#else // SPWFSA_TRACE_SIZE == 0
+    return NSAPI_ERROR_UNSUPPORTED;
+#endif // SPWFSA_TRACE_SIZE == 0
+}
+
+void SpwfSAInterface::dump_trace(void)
+{
+#if SPWFSA_TRACE_SIZE > 0
+    static const char * const names[SPWFSA_TRACE_EVENT_COUNT] = {
+        "SEND", "RECV", "READ_LEN", "READ_IN", "READ_DIRECT", "READ_QUEUED",
+        "PENDING_DATA", "PENDING_NO_WIND", "SOCK_CLOSED", "WINDS_OFF", "WINDS_ON"
+    };
+    spwfsa_trace_event_t event;
+
+    SYNC_HANDLER;
+
+    while(_spwf.readTrace(&event, 1) == 1) {
+        printf("SPWF# %10lu %-16s %2d %6ld %6ld\r\n",
+               (unsigned long)event.timestamp,
+               (event.event < SPWFSA_TRACE_EVENT_COUNT) ? names[event.event] : "?",
+               event.spwf_id, (long)event.arg0, (long)event.arg1);
+    }
+#endif // SPWFSA_TRACE_SIZE > 0
+}
+
 #if MBED_CONF_IDW0XX1_PROVIDE_DEFAULT
 
 WiFiInterface *WiFiInterface::get_default_instance() {
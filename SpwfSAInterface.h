@@ -65,6 +65,64 @@
 #define SPWF_SCAN_TIMEOUT       5000
 #define SPWF_MISC_TIMEOUT       301
 #define SPWF_RECV_TIMEOUT       300
+#define SPWF_ASSOC_POLL_PERIOD  100
+#define SPWF_WINDS_HOLD_TIME    50
+
+/* Maximum number of connection status changes waiting to be reported to the status callback */
+#define SPWFSA_STATUS_QUEUE_SIZE    8
+
+/* TX coalescing of small (TCP) socket writes */
+#if defined(MBED_CONF_IDW0XX1_TX_COALESCING)
+#define SPWFSA_TX_COALESCING        (MBED_CONF_IDW0XX1_TX_COALESCING)
+#else
+#define SPWFSA_TX_COALESCING        (0)
+#endif
+#if defined(MBED_CONF_IDW0XX1_TX_FLUSH_TIMEOUT)
+#define SPWF_TX_FLUSH_TIMEOUT       (MBED_CONF_IDW0XX1_TX_FLUSH_TIMEOUT)
+#else
+#define SPWF_TX_FLUSH_TIMEOUT       (20)
+#endif
+
+/* Asynchronous (queued) sending of (TCP) socket data by a driver worker thread */
+#if defined(MBED_CONF_IDW0XX1_ASYNC_SEND) && MBED_CONF_RTOS_PRESENT
+#define SPWFSA_ASYNC_SEND           (MBED_CONF_IDW0XX1_ASYNC_SEND)
+#else
+#define SPWFSA_ASYNC_SEND           (0)
+#endif
+/* Driver event thread processing asynchronous indications & prefetching pending data (instead of IRQ context) */
+#if defined(MBED_CONF_IDW0XX1_EVENT_THREAD) && MBED_CONF_RTOS_PRESENT
+#define SPWFSA_EVENT_THREAD         (MBED_CONF_IDW0XX1_EVENT_THREAD)
+#else
+#define SPWFSA_EVENT_THREAD         (0)
+#endif
+
+/* Asynchronous (deferred) closing of sockets by a driver worker thread */
+#if defined(MBED_CONF_IDW0XX1_ASYNC_CLOSE) && MBED_CONF_RTOS_PRESENT
+#define SPWFSA_ASYNC_CLOSE          (MBED_CONF_IDW0XX1_ASYNC_CLOSE)
+#else
+#define SPWFSA_ASYNC_CLOSE          (0)
+#endif
+
+/* Periodic background RSSI sampling (in ms) by the driver worker thread while connected */
+#if defined(MBED_CONF_IDW0XX1_RSSI_SAMPLE_PERIOD) && MBED_CONF_RTOS_PRESENT
+#define SPWFSA_RSSI_SAMPLE_PERIOD   (MBED_CONF_IDW0XX1_RSSI_SAMPLE_PERIOD)
+#else
+#define SPWFSA_RSSI_SAMPLE_PERIOD   (0)
+#endif
+#if defined(MBED_CONF_IDW0XX1_ASYNC_SEND_BUFFER_SIZE)
+#define SPWFSA_TX_RING_SIZE         (MBED_CONF_IDW0XX1_ASYNC_SEND_BUFFER_SIZE)
+#else
+#define SPWFSA_TX_RING_SIZE         (1024)
+#endif
+
+/* Driver specific socket options (to be used with `Socket::setsockopt()`) */
+#define SPWFSA_SOCKOPT_LEVEL        (0x5350)
+#define SPWFSA_SOCKOPT_TX_COALESCE  (1) // `int`: enable (`!= 0`) or disable (`== 0`) TX coalescing (TCP only)
+#define SPWFSA_SOCKOPT_TX_FLUSH     (2) // send out TX coalesced data immediately (no value)
+#define SPWFSA_SOCKOPT_TX_ASYNC     (3) // `int`: enable (`!= 0`) or disable (`== 0`) asynchronous sending (TCP only)
+
+/* Buffer descriptor for scatter-gather socket I/O (`buffer` & `len`) */
+typedef SPWFSAxx::chunk spwfsa_iovec_t;
 
 /** SpwfSAInterface class
  *  Implementation of the NetworkStack for the SPWF Device
@@ -132,6 +190,33 @@ public:
      */
     virtual nsapi_error_t disconnect();
 
+    /** Register callback for status reporting
+     *
+     *  The callback gets called with `NSAPI_EVENT_CONNECTION_STATUS_CHANGE` & the new
+     *  `nsapi_connection_status_t` each time the connection status changes
+     *  (i.e. CONNECTING -> LOCAL_UP (WiFi up, no IP address yet) -> GLOBAL_UP, or -> DISCONNECTED).
+     *
+     *  @param status_cb    The callback for status changes
+     *  @note In non-blocking mode the callback gets called from a driver worker thread
+     */
+    virtual void attach(Callback<void(nsapi_event_t, intptr_t)> status_cb);
+
+    /** Get the connection status
+     *
+     *  @return             The connection status according to `nsapi_connection_status_t`
+     */
+    virtual nsapi_connection_status_t get_connection_status() const;
+
+    /** Set blocking status of connect()
+     *
+     *  In non-blocking mode `connect()` configures the module & starts the association,
+     *  then returns without waiting for `+WIND:24`. Progress is reported through the status callback.
+     *
+     *  @param blocking     true if connect is blocking (default)
+     *  @return             0 on success, NSAPI_ERROR_UNSUPPORTED if non-blocking mode is not available (no RTOS)
+     */
+    virtual nsapi_error_t set_blocking(bool blocking);
+
     /** Get the internally stored IP address
      *  @return             IP address of the interface or null if not yet connected
      */
@@ -175,6 +260,130 @@ public:
      */
     virtual nsapi_size_or_error_t scan(WiFiAccessPoint *res, unsigned count);
 
+    /** Scan for available networks, delivering each result as soon as it has been received
+     *
+     *  This function will block, but does not need any result array. The @a cb is called for each
+     *  discovered AP matching @a filter (e.g. `{"my_ssid", -80, NSAPI_SECURITY_WPA2}`) and may stop
+     *  the delivery of further APs by returning false.
+     *
+     *  @param  cb       Callback to be called for each (matching) discovered AP
+     *  @param  filter   Filter on SSID, minimum RSSI and security, or NULL to get all APs
+     *  @return          Number of APs delivered to @a cb, negative on error see @a nsapi_error
+     *  @note   @a cb is called while the driver is locked, it must not call back into this interface
+     */
+    nsapi_size_or_error_t scan_stream(spwfsa_scan_cb_t cb, const spwfsa_scan_filter_t *filter = NULL);
+
+    /** Get usage statistics of the receive packet pool
+     *
+     *  @param max_used     Maximum number of pool slots which have been in use at the same time
+     *  @param exhausted    Number of packet allocations which failed due to an exhausted pool
+     */
+    void get_packet_pool_stats(unsigned int *max_used, unsigned int *exhausted);
+
+    /** Get receive path statistics
+     *
+     *  @param at_cmds      Number of AT commands issued for receiving data (incl. switching WINDs on/off)
+     *  @param bytes        Number of bytes received from the module
+     *  @note The ratio of both values gives the AT command overhead per received byte
+     */
+    void get_recv_stats(uint32_t *at_cmds, uint32_t *bytes);
+
+    /** Get socket close statistics
+     *
+     *  @param stats        Placeholder for the statistics (number of closes, drained bytes, close latency)
+     *  @note With `idw0xx1.async-close` enabled, the latency covers the background draining & closing
+     */
+    void get_close_stats(spwfsa_close_stats_t *stats);
+
+    /** Get duration of the phases of the last successful connect
+     *
+     *  @param timing       Placeholder for the phase durations (configuration, flash save & reset, join)
+     *  @note With `idw0xx1.fast-reconnect` enabled, reconnecting with unchanged credentials skips the first two phases
+     */
+    void get_connect_timing(spwfsa_connect_timing_t *timing);
+
+    /** Get latency histogram of an AT command class
+     *
+     *  @param cmd_class    AT command class (e.g. `SPWFSA_AT_SOCKW`)
+     *  @param stats        Placeholder for the histogram (see `spwfsa_at_latency_t` for bucket bounds)
+     *  @return             0 on success, NSAPI_ERROR_UNSUPPORTED if `idw0xx1.at-latency-stats` is not enabled,
+     *                      NSAPI_ERROR_PARAMETER for invalid `cmd_class`
+     */
+    nsapi_error_t get_at_latency_stats(spwfsa_at_class_t cmd_class, spwfsa_at_latency_t *stats);
+
+    /** Reset latency histograms of all AT command classes
+     */
+    void reset_at_latency_stats(void);
+
+    /** Read (and remove) recorded driver trace events, oldest first
+     *
+     *  @param events       Placeholder for events
+     *  @param count        Maximum number of events to read
+     *  @return             Number of events read, NSAPI_ERROR_UNSUPPORTED if `idw0xx1.trace-buffer-size` is `0`
+     *  @note Events get recorded without locking, i.e. an event being read while the trace ring wraps around
+     *        might be inconsistent
+     */
+    nsapi_size_or_error_t read_trace(spwfsa_trace_event_t *events, unsigned int count);
+
+    /** Print (and remove) all recorded driver trace events in human readable form
+     */
+    void dump_trace(void);
+
+    /** Send data to the remote host, gathering it from several buffers
+     *
+     *  All buffers are sent out with as few `AT+S.SOCKW` commands as possible (i.e. one per 730 bytes),
+     *  without the need to concatenate them into a temporary buffer first.
+     *
+     *  @param handle       Socket handle (as returned by `socket_open()`)
+     *  @param iov          Buffers to send (not modified)
+     *  @param iovcnt       Number of buffers
+     *  @return             Number of written bytes on success, negative on failure
+     */
+    nsapi_size_or_error_t socket_sendv(nsapi_socket_t handle, const spwfsa_iovec_t *iov, unsigned int iovcnt);
+
+    /** Receive data from the remote host, scattering it into several buffers
+     *
+     *  Buffers get filled one after the other directly from the driver's receive packets.
+     *  For UDP sockets at most one datagram is received, any excess data gets discarded.
+     *
+     *  @param handle       Socket handle (as returned by `socket_open()`)
+     *  @param iov          Buffers in which to store the data received from the host
+     *  @param iovcnt       Number of buffers
+     *  @return             Number of received bytes on success, negative on failure
+     *  @note This call is not-blocking, if this call would block,
+     *        NSAPI_ERROR_WOULD_BLOCK is returned
+     */
+    nsapi_size_or_error_t socket_recvv(nsapi_socket_t handle, spwfsa_iovec_t *iov, unsigned int iovcnt);
+
+    /** Send data to the remote host of an (opened & connected) socket, gathering it from several buffers
+     *
+     *  Same as `socket_sendv(nsapi_socket_t, ...)`, but for mbed sockets opened on this interface.
+     *
+     *  @param socket       TCP resp. UDP socket
+     *  @param iov          Buffers to send (not modified)
+     *  @param iovcnt       Number of buffers
+     *  @return             Number of written bytes on success, negative on failure
+     *                      (NSAPI_ERROR_NO_SOCKET if `socket` has not been opened on this interface)
+     *  @note The socket's timeout & blocking mode are not applied
+     */
+    nsapi_size_or_error_t socket_sendv(TCPSocket &socket, const spwfsa_iovec_t *iov, unsigned int iovcnt);
+    nsapi_size_or_error_t socket_sendv(UDPSocket &socket, const spwfsa_iovec_t *iov, unsigned int iovcnt);
+
+    /** Receive data from the remote host of an (opened & connected) socket, scattering it into several buffers
+     *
+     *  Same as `socket_recvv(nsapi_socket_t, ...)`, but for mbed sockets opened on this interface.
+     *
+     *  @param socket       TCP resp. UDP socket
+     *  @param iov          Buffers in which to store the data received from the host
+     *  @param iovcnt       Number of buffers
+     *  @return             Number of received bytes on success, negative on failure
+     *                      (NSAPI_ERROR_NO_SOCKET if `socket` has not been opened on this interface)
+     *  @note This call is not-blocking (independently of the socket's blocking mode), if this call would block,
+     *        NSAPI_ERROR_WOULD_BLOCK is returned
+     */
+    nsapi_size_or_error_t socket_recvv(TCPSocket &socket, spwfsa_iovec_t *iov, unsigned int iovcnt);
+    nsapi_size_or_error_t socket_recvv(UDPSocket &socket, spwfsa_iovec_t *iov, unsigned int iovcnt);
+
     /** Translates a hostname to an IP address with specific version
      *
      *  The hostname may be either a domain name or an IP address. If the
@@ -304,6 +513,20 @@ private:
      */
     virtual void socket_attach(void *handle, void (*callback)(void *), void *data);
 
+    /** Set driver specific socket options
+     *  @param handle       Socket handle
+     *  @param level        Option level (only `SPWFSA_SOCKOPT_LEVEL` is supported)
+     *  @param optname      Level-specific option name (`SPWFSA_SOCKOPT_TX_COALESCE` or `SPWFSA_SOCKOPT_TX_FLUSH`)
+     *  @param optval       Option value
+     *  @param optlen       Length of the option value
+     *  @return             `NSAPI_ERROR_OK` on success, negative on failure
+     *  @note TX coalescing is only available if `idw0xx1.tx-coalescing` has been enabled
+     *  @note Once `idw0xx1.tx-flush-timeout` has expired, coalesced data gets sent out by the driver worker thread
+     *        (RTOS present), resp. by the next call into the socket (bare metal, the socket callback is triggered
+     *        for this purpose); errors of this flush are reported by the next `send()`, unsent data is kept
+     */
+    virtual nsapi_error_t setsockopt(nsapi_socket_t handle, int level, int optname, const void *optval, unsigned optlen);
+
     /** Provide access to the NetworkStack object
      *
      *  @return The underlying NetworkStack object
@@ -355,6 +578,39 @@ private:
         return (sock.spwf_id != SPWFSA_SOCKET_COUNT);
     }
 
+#if SPWFSA_TX_COALESCING
+    /* fetch & clear error latched by flushing coalesced data on deadline */
+    nsapi_error_t _socket_tx_flush_err(int internal_id) {
+        nsapi_error_t err = _tx_bufs[internal_id].err;
+
+        _tx_bufs[internal_id].err = NSAPI_ERROR_OK;
+        return err;
+    }
+#endif // SPWFSA_TX_COALESCING
+
+    /* queued data of `sock` may be received without taking the driver (UART) lock */
+    bool _socket_recv_queued_ok(spwf_socket_t *sock) {
+#if SPWFSA_TX_COALESCING
+        if(_tx_flush_due) return false; // flush deadline expired, flushing needs the driver lock
+#endif // SPWFSA_TX_COALESCING
+        return (_socket_has_connected(sock) && !sock->no_more_data);
+    }
+
+    /* publish resp. fetch callback & data of a socket as a whole (`event()` may run in IRQ context) */
+    void _set_socket_cb(int internal_id, void (*callback)(void *), void *data) {
+        core_util_critical_section_enter();
+        _cbs[internal_id].callback = callback;
+        _cbs[internal_id].data = data;
+        core_util_critical_section_exit();
+    }
+
+    void _get_socket_cb(int internal_id, void (**callback)(void *), void **data) {
+        core_util_critical_section_enter();
+        *callback = _cbs[internal_id].callback;
+        *data = _cbs[internal_id].data;
+        core_util_critical_section_exit();
+    }
+
     bool _socket_is_still_connected(int internal_id) {
         if(!_socket_has_connected(internal_id)) return false;
 
@@ -378,6 +634,15 @@ private:
     bool _dbg_on;
     bool _connected_to_network;
 
+    Callback<void(nsapi_event_t, intptr_t)> _status_cb;
+    volatile nsapi_connection_status_t _conn_status;
+
+    /* status changes not yet reported to `_status_cb` (protected by the driver lock) */
+    nsapi_connection_status_t _status_queue[SPWFSA_STATUS_QUEUE_SIZE];
+    unsigned int _status_queue_head;
+    unsigned int _status_queue_len;
+    bool _blocking;
+
     spwf_socket_t _ids[SPWFSA_SOCKET_COUNT];
     struct {
         void (*callback)(void *);
@@ -385,10 +650,53 @@ private:
     } _cbs[SPWFSA_SOCKET_COUNT];
     int _internal_ids[SPWFSA_SOCKET_COUNT];
 
+    /* copies of cached network parameters returned by the getters */
+    char _cached_ip[16];
+    char _cached_gateway[16];
+    char _cached_netmask[16];
+    char _cached_mac[18];
+
 #if MBED_CONF_RTOS_PRESENT
     Mutex _spwf_mutex;
+
+    /* non-blocking association, network loss recovery, deferred closes
+     * & (with `SPWFSA_EVENT_THREAD`) UART event processing (driven by `_worker_thread`) */
+    Semaphore _worker_sem;
+    Thread _worker_thread;
+    volatile bool _worker_thread_started; // also read in IRQ context
 #endif
 
+#if SPWFSA_TX_COALESCING
+    /* TX coalescing buffers (indexed by `internal_id`) */
+    struct {
+        bool enabled;
+        nsapi_error_t err; // error of flushing on deadline, to be reported by next `socket_send()`
+        uint16_t len;
+        uint8_t data[SPWFXX_SEND_RECV_PKTSIZE];
+    } _tx_bufs[SPWFSA_SOCKET_COUNT];
+
+    Timeout _tx_flush_timeout;
+    volatile bool _tx_flush_armed;
+    volatile bool _tx_flush_due;
+#endif // SPWFSA_TX_COALESCING
+
+#if SPWFSA_ASYNC_SEND
+    /* TX rings of asynchronous sending (indexed by `internal_id`, protected by `_tx_mutex`,
+     * `enabled` gets written holding `_spwf_mutex` as well) */
+    struct {
+        bool enabled;
+        nsapi_error_t err; // error of asynchronous sending, to be reported by next `socket_send()`
+        uint16_t start;
+        uint16_t len;
+        uint8_t data[SPWFSA_TX_RING_SIZE];
+    } _tx_rings[SPWFSA_SOCKET_COUNT];
+
+    Mutex _tx_mutex;
+    Semaphore _tx_sem;
+    Thread _tx_thread;
+    bool _tx_thread_started;
+#endif // SPWFSA_ASYNC_SEND
+
     char ap_ssid[33]; /* 32 is what 802.11 defines as longest possible name; +1 for the \0 */
     nsapi_security_t ap_sec;
     char ap_pass[64]; /* The longest allowed passphrase */
@@ -396,7 +704,48 @@ private:
 private:
     void event(void);
     nsapi_error_t init(void);
+    nsapi_size_or_error_t _scan(WiFiAccessPoint *res, unsigned count,
+                                spwfsa_scan_cb_t cb, const spwfsa_scan_filter_t *filter);
     nsapi_size_or_error_t _socket_recv(void *handle, void *data, unsigned size, bool datagram);
+    void _set_conn_status(nsapi_connection_status_t status);
+    void _report_conn_status(void);
+    nsapi_connection_status_t _get_conn_status(void);
+    bool _check_connected(void);
+
+#if MBED_CONF_RTOS_PRESENT
+    void _worker_thread_loop(void);
+#endif
+
+    /* Get driver handle of an mbed socket (NULL if not opened on this interface),
+     * the handle is a protected member of mbed's socket classes */
+    template<typename S>
+    nsapi_socket_t _get_socket_handle(S &socket) {
+        struct handle_accessor : public S {
+            static nsapi_socket_t get(S &s) {
+                return s.*(&handle_accessor::_socket);
+            }
+        };
+
+        uintptr_t handle = (uintptr_t)handle_accessor::get(socket);
+        if((handle < (uintptr_t)&_ids[0]) || (handle >= (uintptr_t)&_ids[SPWFSA_SOCKET_COUNT])
+                || (((handle - (uintptr_t)&_ids[0]) % sizeof(spwf_socket_t)) != 0)) {
+            return NULL;
+        }
+        return (nsapi_socket_t)handle;
+    }
+
+#if SPWFSA_TX_COALESCING
+    nsapi_size_or_error_t _socket_send_coalesced(spwf_socket_t *socket, const void *data, unsigned size);
+    nsapi_error_t _socket_tx_flush(spwf_socket_t *socket);
+    void _tx_flush_expired(void);
+    void _tx_flush_timeout_handler(void);
+#endif // SPWFSA_TX_COALESCING
+
+#if SPWFSA_ASYNC_SEND
+    nsapi_size_or_error_t _socket_send_async(spwf_socket_t *socket, const void *data, unsigned size, bool *async);
+    bool _socket_tx_drain(spwf_socket_t *socket);
+    void _tx_thread_loop(void);
+#endif // SPWFSA_ASYNC_SEND
 
 
     int get_internal_id(int spwf_id) { // checks also if `spwf_id` is (still) "valid"
@@ -412,8 +761,9 @@ private:
         }
     }
 
-    /* Called at initialization or after module hard fault */
-    void inner_constructor() {
+    /* Called at initialization or after module hard fault
+     * (resp. with `deinit == false` after a fast disconnect, keeping the module initialized) */
+    void inner_constructor(bool deinit = true) {
         memset(_ids, 0, sizeof(_ids));
         memset(_cbs, 0, sizeof(_cbs));
 
@@ -423,10 +773,27 @@ private:
             _internal_ids[sock_cnt] = SPWFSA_SOCKET_COUNT;
         }
 
+#if SPWFSA_TX_COALESCING
+        memset(_tx_bufs, 0, sizeof(_tx_bufs));
+        _tx_flush_armed = false;
+        _tx_flush_due = false;
+#endif // SPWFSA_TX_COALESCING
+
+#if SPWFSA_ASYNC_SEND
+        {
+            ScopedMutexLock tx_sync_handler(_tx_mutex);
+            memset(_tx_rings, 0, sizeof(_tx_rings));
+        }
+#endif // SPWFSA_ASYNC_SEND
+
         _spwf.attach(this, &SpwfSAInterface::event);
 
         _connected_to_network = false;
-        _isInitialized = false;
+        if(deinit) {
+            _isInitialized = false;
+        }
+
+        _set_conn_status(NSAPI_STATUS_DISCONNECTED);
     }
 
 private:
@@ -436,7 +803,7 @@ private:
 };
 
 #define CHECK_NOT_CONNECTED_ERR() { \
-        if(!_connected_to_network) return NSAPI_ERROR_NO_CONNECTION; \
+        if(!_check_connected()) return NSAPI_ERROR_NO_CONNECTION; \
 } \
 
 
@@ -0,0 +1,794 @@
+/* SPWFSAxx Devices - host benchmarks
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Throughput & latency benchmarks of the driver (as configured by the build) over the simulated module
+ *
+ * All loops go through `SpwfSAInterface` & the mbed socket classes, i.e. through the driver's real
+ * `send()`/`recv()`/`_read_in_pending()` paths. Results get written one line per run (CSV or JSON lines),
+ * see `../README.md`.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "SimBoard.h"
+#include "LoopbackPeer.h"
+
+using namespace spwf_sim;
+
+#if defined(MBED_CONF_IDW0XX1_CONSOLE_SPEED)
+#define BENCH_BAUD      (MBED_CONF_IDW0XX1_CONSOLE_SPEED)
+#else
+#define BENCH_BAUD      (115200)
+#endif
+
+#if MBED_CONF_IDW0XX1_EXPANSION_BOARD == IDW04A1
+#define BENCH_BOARD     "IDW04A1"
+#else
+#define BENCH_BOARD     "IDW01M1"
+#endif
+
+#define BENCH_TIMEOUT_S (120)   // per run
+
+typedef std::chrono::steady_clock bench_clock;
+
+static const char *const bench_names[] = {
+    "tcp_up", "tcp_down", "udp_tx", "udp_rx", "rtt", "open_close", "scan"
+};
+
+struct Options {
+    std::vector<std::string> benches;
+    std::vector<unsigned> sockets;
+    std::vector<unsigned> sizes;    // empty: per benchmark defaults
+    unsigned bytes;                 // per run (split among sockets)
+    unsigned iterations;
+    unsigned cmd_latency_us;
+    bool json;
+    bool header;
+    bool quick;
+};
+
+static Options opts;
+static unsigned total_errors = 0;
+
+struct Result {
+    Result(const char *bench, const char *variant, unsigned sockets, unsigned size)
+    : bench(bench), variant(variant), sockets(sockets), size(size),
+      ops(0), bytes(0), seconds(0), at_cmds(0), uart_bytes(0), lost(0), errors(0) {}
+
+    const char *bench;
+    const char *variant;
+    unsigned sockets;
+    unsigned size;
+    uint64_t ops;
+    uint64_t bytes;
+    double seconds;
+    std::vector<double> latencies_us;   // per operation
+    uint32_t at_cmds;                   // AT commands processed by the module
+    uint64_t uart_bytes;                // both directions
+    uint64_t lost;                      // datagrams lost (UDP) resp. UART RX overflows (scan)
+    uint64_t errors;                    // failed operations & data mismatches
+};
+
+struct Context {
+    SpwfSAInterface &wifi;
+    SimBoard &board;
+    LoopbackPeer &peer;
+};
+
+/* wakes up benchmark loops on socket events (`sigio`) */
+class Waiter {
+public:
+    Waiter() : _events(0) {}
+
+    void notify(void) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _events++;
+        _cv.notify_all();
+    }
+
+    uint64_t events(void) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _events;
+    }
+
+    /* wait for an event after `seen` */
+    void wait(uint64_t seen, unsigned ms) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait_for(lock, std::chrono::milliseconds(ms), [&]() {
+            return _events != seen;
+        });
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    uint64_t _events;
+};
+
+static Waiter waiter;
+
+static void socket_event(void)
+{
+    waiter.notify();
+}
+
+static double elapsed_us(bench_clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(bench_clock::now() - start).count();
+}
+
+static bool timed_out(bench_clock::time_point start)
+{
+    return (bench_clock::now() - start) > std::chrono::seconds(BENCH_TIMEOUT_S);
+}
+
+/* run time & module side AT command/UART statistics of a run */
+class Measurement {
+public:
+    Measurement(Context &ctx, Result &result)
+    : _ctx(ctx), _result(result), _stats(ctx.board.sim.stats()), _start(bench_clock::now()) {}
+
+    void stop(void) {
+        Stats stats = _ctx.board.sim.stats();
+
+        _result.seconds = elapsed_us(_start) / 1e6;
+        _result.at_cmds = stats.commands - _stats.commands;
+        _result.uart_bytes = (stats.uart_rx_bytes - _stats.uart_rx_bytes) + (stats.uart_tx_bytes - _stats.uart_tx_bytes);
+    }
+
+private:
+    Context &_ctx;
+    Result &_result;
+    Stats _stats;
+    bench_clock::time_point _start;
+};
+
+static double percentile(std::vector<double> values, double p)
+{
+    if(values.empty()) return 0;
+
+    std::sort(values.begin(), values.end());
+    size_t idx = (size_t)(p * (values.size() - 1) + 0.5);
+    return values[idx];
+}
+
+static void emit(const Result &r)
+{
+    static const char *const columns =
+        "board,baud,bench,variant,sockets,size,ops,bytes,seconds,ops_per_s,kib_per_s,us_per_op,p50_us,p99_us,"
+        "at_cmds,uart_bytes,lost,errors";
+    double ops_per_s = (r.seconds > 0) ? (r.ops / r.seconds) : 0;
+    double kib_per_s = (r.seconds > 0) ? (r.bytes / 1024.0 / r.seconds) : 0;
+    double us_per_op = (r.ops > 0) ? (r.seconds * 1e6 / r.ops) : 0;
+    double p50 = percentile(r.latencies_us, 0.50);
+    double p99 = percentile(r.latencies_us, 0.99);
+
+    total_errors += r.errors;
+
+    if(opts.json) {
+        printf("{\"board\":\"%s\",\"baud\":%d,\"bench\":\"%s\",\"variant\":\"%s\",\"sockets\":%u,\"size\":%u,"
+               "\"ops\":%llu,\"bytes\":%llu,\"seconds\":%.6f,\"ops_per_s\":%.1f,\"kib_per_s\":%.2f,"
+               "\"us_per_op\":%.1f,\"p50_us\":%.1f,\"p99_us\":%.1f,\"at_cmds\":%u,\"uart_bytes\":%llu,"
+               "\"lost\":%llu,\"errors\":%llu}\n",
+               BENCH_BOARD, BENCH_BAUD, r.bench, r.variant, r.sockets, r.size,
+               (unsigned long long)r.ops, (unsigned long long)r.bytes, r.seconds, ops_per_s, kib_per_s,
+               us_per_op, p50, p99, r.at_cmds, (unsigned long long)r.uart_bytes,
+               (unsigned long long)r.lost, (unsigned long long)r.errors);
+    } else {
+        if(opts.header) {
+            printf("%s\n", columns);
+            opts.header = false;
+        }
+        printf("%s,%d,%s,%s,%u,%u,%llu,%llu,%.6f,%.1f,%.2f,%.1f,%.1f,%.1f,%u,%llu,%llu,%llu\n",
+               BENCH_BOARD, BENCH_BAUD, r.bench, r.variant, r.sockets, r.size,
+               (unsigned long long)r.ops, (unsigned long long)r.bytes, r.seconds, ops_per_s, kib_per_s,
+               us_per_op, p50, p99, r.at_cmds, (unsigned long long)r.uart_bytes,
+               (unsigned long long)r.lost, (unsigned long long)r.errors);
+    }
+    fflush(stdout);
+}
+
+/* TCP sockets connected to the peer's `mode` server, `variant` selects the driver's TX path */
+static bool open_tcp(Context &ctx, std::vector<TCPSocket *> &sockets, unsigned count,
+                     LoopbackPeer::mode_t mode, const char *variant)
+{
+    for(unsigned i = 0; i < count; i++) {
+        TCPSocket *socket = new TCPSocket();
+
+        sockets.push_back(socket);
+        if(socket->open(&ctx.wifi) != NSAPI_ERROR_OK) return false;
+        socket->set_timeout(10000);
+        socket->sigio(mbed::callback(socket_event));
+
+        int enable = 1;
+        if(strcmp(variant, "coalesce") == 0) {
+            socket->setsockopt(SPWFSA_SOCKOPT_LEVEL, SPWFSA_SOCKOPT_TX_COALESCE, &enable, sizeof(enable));
+        } else if(strcmp(variant, "async") == 0) {
+            socket->setsockopt(SPWFSA_SOCKOPT_LEVEL, SPWFSA_SOCKOPT_TX_ASYNC, &enable, sizeof(enable));
+        }
+
+        if(socket->connect("127.0.0.1", ctx.peer.tcp_port(mode)) != NSAPI_ERROR_OK) return false;
+    }
+    return true;
+}
+
+template <typename S>
+static void close_all(std::vector<S *> &sockets)
+{
+    for(size_t i = 0; i < sockets.size(); i++) {
+        sockets[i]->close();
+        delete sockets[i];
+    }
+    sockets.clear();
+}
+
+static std::vector<const char *> tx_variants(void)
+{
+    std::vector<const char *> variants(1, "plain");
+#if SPWFSA_TX_COALESCING
+    variants.push_back("coalesce");
+#endif // SPWFSA_TX_COALESCING
+#if SPWFSA_ASYNC_SEND
+    variants.push_back("async");
+#endif // SPWFSA_ASYNC_SEND
+    return variants;
+}
+
+/* bulk upload in writes of `size` bytes, until the peer has received everything */
+static void bench_tcp_up(Context &ctx, unsigned nsockets, unsigned size, const char *variant)
+{
+    Result r("tcp_up", variant, nsockets, size);
+    std::vector<TCPSocket *> sockets;
+    std::vector<uint8_t> buf(size);
+    uint64_t per_socket = std::max<uint64_t>(opts.bytes / nsockets, size);
+    std::vector<uint64_t> left(nsockets, per_socket);
+
+    for(unsigned i = 0; i < size; i++) buf[i] = LoopbackPeer::pattern(i);
+
+    if(!open_tcp(ctx, sockets, nsockets, LoopbackPeer::PEER_DISCARD, variant)) {
+        r.errors++;
+        close_all(sockets);
+        emit(r);
+        return;
+    }
+
+    uint64_t peer_start = ctx.peer.bytes_received();
+    bench_clock::time_point start = bench_clock::now();
+    Measurement m(ctx, r);
+
+    for(bool busy = true; busy && !timed_out(start);) {
+        uint64_t seen = waiter.events();
+        bool blocked = false;
+
+        busy = false;
+        for(unsigned i = 0; i < nsockets; i++) {
+            if(left[i] == 0) continue;
+            busy = true;
+
+            bench_clock::time_point t0 = bench_clock::now();
+            nsapi_size_or_error_t ret = sockets[i]->send(&buf[0], (unsigned)std::min<uint64_t>(size, left[i]));
+            if(ret == NSAPI_ERROR_WOULD_BLOCK) {
+                blocked = true;
+                continue;
+            }
+            if(ret <= 0) {
+                r.errors++;
+                left[i] = 0;
+                continue;
+            }
+            r.latencies_us.push_back(elapsed_us(t0));
+            r.ops++;
+            r.bytes += ret;
+            left[i] -= ret;
+        }
+        if(blocked) waiter.wait(seen, 10);
+    }
+
+    if(strcmp(variant, "coalesce") == 0) {
+        for(unsigned i = 0; i < nsockets; i++) {
+            sockets[i]->setsockopt(SPWFSA_SOCKOPT_LEVEL, SPWFSA_SOCKOPT_TX_FLUSH, NULL, 0);
+        }
+    }
+    while(((ctx.peer.bytes_received() - peer_start) < r.bytes) && !timed_out(start)) {
+        usleep(500);
+    }
+    m.stop();
+
+    if((ctx.peer.bytes_received() - peer_start) != r.bytes) r.errors++;
+    close_all(sockets);
+    emit(r);
+}
+
+/* bulk download, read in `size` byte calls (non-blocking, round robin over all sockets) */
+static void bench_tcp_down(Context &ctx, unsigned nsockets, unsigned size)
+{
+    Result r("tcp_down", "plain", nsockets, size);
+    std::vector<TCPSocket *> sockets;
+    std::vector<uint8_t> buf(size);
+    uint32_t per_socket = std::max<uint32_t>(opts.bytes / nsockets, 1);
+    std::vector<uint64_t> pos(nsockets, 0);
+    std::vector<bool> done(nsockets, false);
+
+    if(!open_tcp(ctx, sockets, nsockets, LoopbackPeer::PEER_SOURCE, "plain")) {
+        r.errors++;
+        close_all(sockets);
+        emit(r);
+        return;
+    }
+
+    bench_clock::time_point start = bench_clock::now();
+    Measurement m(ctx, r);
+
+    uint32_t request = htonl(per_socket);
+    for(unsigned i = 0; i < nsockets; i++) {
+        if(sockets[i]->send(&request, sizeof(request)) != (nsapi_size_or_error_t)sizeof(request)) {
+            r.errors++;
+            done[i] = true;
+        }
+        sockets[i]->set_blocking(false);
+    }
+
+    for(unsigned finished = 0; (finished < nsockets) && !timed_out(start);) {
+        uint64_t seen = waiter.events();
+        bool progress = false;
+
+        for(unsigned i = 0; i < nsockets; i++) {
+            if(done[i]) continue;
+
+            bench_clock::time_point t0 = bench_clock::now();
+            nsapi_size_or_error_t ret = sockets[i]->recv(&buf[0], size);
+            if(ret > 0) {
+                r.latencies_us.push_back(elapsed_us(t0));
+                for(nsapi_size_or_error_t j = 0; j < ret; j++) {
+                    if(buf[j] != LoopbackPeer::pattern(pos[i] + j)) {
+                        r.errors++;
+                        break;
+                    }
+                }
+                pos[i] += ret;
+                r.ops++;
+                r.bytes += ret;
+                progress = true;
+            } else if(ret != NSAPI_ERROR_WOULD_BLOCK) { // EOF (resp. error)
+                if((ret < 0) || (pos[i] != per_socket)) r.errors++;
+                done[i] = true;
+                finished++;
+                progress = true;
+            }
+        }
+        if(!progress) waiter.wait(seen, 100);
+    }
+    m.stop();
+
+    close_all(sockets);
+    emit(r);
+}
+
+static void bench_udp_tx(Context &ctx, unsigned nsockets, unsigned size)
+{
+    Result r("udp_tx", "plain", nsockets, size);
+    std::vector<UDPSocket *> sockets;
+    std::vector<uint8_t> buf(size);
+    SocketAddress addr("127.0.0.1", ctx.peer.udp_port(LoopbackPeer::PEER_DISCARD));
+    unsigned per_socket = std::max(opts.bytes / size / nsockets, 1U);
+
+    for(unsigned i = 0; i < nsockets; i++) {
+        sockets.push_back(new UDPSocket());
+        sockets[i]->open(&ctx.wifi);
+        sockets[i]->set_timeout(10000);
+    }
+
+    uint64_t peer_start = ctx.peer.bytes_received();
+    bench_clock::time_point start = bench_clock::now();
+    Measurement m(ctx, r);
+
+    for(unsigned n = 0; (n < per_socket) && !timed_out(start); n++) {
+        for(unsigned i = 0; i < nsockets; i++) {
+            bench_clock::time_point t0 = bench_clock::now();
+            nsapi_size_or_error_t ret = sockets[i]->sendto(addr, &buf[0], size);
+            if(ret != (nsapi_size_or_error_t)size) {
+                r.errors++;
+                continue;
+            }
+            r.latencies_us.push_back(elapsed_us(t0));
+            r.ops++;
+            r.bytes += ret;
+        }
+    }
+
+    /* let the last datagrams arrive */
+    for(int quiet = 0; ((ctx.peer.bytes_received() - peer_start) < r.bytes) && (quiet < 500); quiet++) {
+        usleep(1000);
+    }
+    m.stop();
+
+    r.lost = (r.bytes - (ctx.peer.bytes_received() - peer_start)) / size;
+    close_all(sockets);
+    emit(r);
+}
+
+/* peer sends a burst of datagrams to each socket, the module drops what does not fit into its buffers */
+static void bench_udp_rx(Context &ctx, unsigned nsockets, unsigned size)
+{
+    Result r("udp_rx", "plain", nsockets, size);
+    std::vector<UDPSocket *> sockets;
+    std::vector<uint8_t> buf(size);
+    SocketAddress addr("127.0.0.1", ctx.peer.udp_port(LoopbackPeer::PEER_SOURCE));
+    uint32_t per_socket = std::max(opts.bytes / size / nsockets, 1U);
+    uint32_t request[2] = { htonl(per_socket), htonl(size) };
+
+    for(unsigned i = 0; i < nsockets; i++) {
+        sockets.push_back(new UDPSocket());
+        sockets[i]->open(&ctx.wifi);
+        sockets[i]->sigio(mbed::callback(socket_event));
+    }
+
+    bench_clock::time_point start = bench_clock::now();
+    bench_clock::time_point last_rx = start;
+    Measurement m(ctx, r);
+
+    for(unsigned i = 0; i < nsockets; i++) {
+        if(sockets[i]->sendto(addr, request, sizeof(request)) != (nsapi_size_or_error_t)sizeof(request)) r.errors++;
+        sockets[i]->set_blocking(false);
+    }
+
+    /* until everything has been received, resp. nothing has arrived for a while */
+    while((r.ops < (uint64_t)per_socket * nsockets) && ((bench_clock::now() - last_rx) < std::chrono::seconds(1))) {
+        uint64_t seen = waiter.events();
+        bool progress = false;
+
+        for(unsigned i = 0; i < nsockets; i++) {
+            bench_clock::time_point t0 = bench_clock::now();
+            nsapi_size_or_error_t ret = sockets[i]->recvfrom(NULL, &buf[0], size);
+            if(ret == NSAPI_ERROR_WOULD_BLOCK) continue;
+            if(ret != (nsapi_size_or_error_t)size) {
+                r.errors++;
+                continue;
+            }
+            r.latencies_us.push_back(elapsed_us(t0));
+            r.ops++;
+            r.bytes += ret;
+            last_rx = bench_clock::now();
+            progress = true;
+        }
+        if(!progress) waiter.wait(seen, 100);
+    }
+    m.stop();
+    if(r.ops > 0) {
+        r.seconds = std::chrono::duration<double>(last_rx - start).count(); // without the final idle time
+    }
+
+    r.lost = (uint64_t)per_socket * nsockets - r.ops;
+    close_all(sockets);
+    emit(r);
+}
+
+/* request/response: `size` bytes to the echo server & back, round robin over all sockets */
+static void bench_rtt(Context &ctx, unsigned nsockets, unsigned size)
+{
+    Result r("rtt", "plain", nsockets, size);
+    std::vector<TCPSocket *> sockets;
+    std::vector<uint8_t> tx(size), rx(size);
+
+    for(unsigned i = 0; i < size; i++) tx[i] = LoopbackPeer::pattern(i);
+
+    if(!open_tcp(ctx, sockets, nsockets, LoopbackPeer::PEER_ECHO, "plain")) {
+        r.errors++;
+        close_all(sockets);
+        emit(r);
+        return;
+    }
+
+    Measurement m(ctx, r);
+
+    for(unsigned n = 0; n < opts.iterations; n++) {
+        for(unsigned i = 0; i < nsockets; i++) {
+            bench_clock::time_point t0 = bench_clock::now();
+            bool ok = true;
+
+            for(unsigned sent = 0; ok && (sent < size);) {
+                nsapi_size_or_error_t ret = sockets[i]->send(&tx[sent], size - sent);
+                if(ret <= 0) ok = false;
+                else sent += ret;
+            }
+            for(unsigned received = 0; ok && (received < size);) {
+                nsapi_size_or_error_t ret = sockets[i]->recv(&rx[received], size - received);
+                if(ret <= 0) ok = false;
+                else received += ret;
+            }
+
+            if(!ok || (memcmp(&tx[0], &rx[0], size) != 0)) {
+                r.errors++;
+                continue;
+            }
+            r.latencies_us.push_back(elapsed_us(t0));
+            r.ops++;
+            r.bytes += 2 * size;
+        }
+    }
+    m.stop();
+
+    close_all(sockets);
+    emit(r);
+}
+
+/* open & connect `nsockets` sockets, then close them all again */
+static void bench_open_close(Context &ctx, unsigned nsockets)
+{
+    Result r("open_close", "plain", nsockets, 0);
+    Measurement m(ctx, r);
+
+    for(unsigned n = 0; n < opts.iterations; n++) {
+        std::vector<TCPSocket *> sockets;
+        bench_clock::time_point t0 = bench_clock::now();
+
+        if(!open_tcp(ctx, sockets, nsockets, LoopbackPeer::PEER_ECHO, "plain")) r.errors++;
+        close_all(sockets);
+
+        r.latencies_us.push_back(elapsed_us(t0) / nsockets);
+        r.ops += nsockets;
+    }
+    m.stop();
+
+    emit(r);
+}
+
+static std::vector<AccessPoint> make_aps(unsigned count)
+{
+    static const char *const security[] = { "WPA2", "WPA WPA2", "", "WEP", "WPA" };
+    std::vector<AccessPoint> aps(count);
+    char ssid[33];
+
+    for(unsigned i = 0; i < count; i++) {
+        snprintf(ssid, sizeof(ssid), "office-ap-%04u", i);
+        aps[i].ssid = ssid;
+        aps[i].bssid[0] = 0x02;
+        aps[i].bssid[1] = 0x00;
+        aps[i].bssid[2] = 0x5E;
+        aps[i].bssid[3] = 0x10;
+        aps[i].bssid[4] = (uint8_t)(i >> 8);
+        aps[i].bssid[5] = (uint8_t)i;
+        aps[i].channel = 1 + (i % 13);
+        aps[i].rssi = -30 - (int)(i % 60);
+        aps[i].security = security[i % (sizeof(security) / sizeof(security[0]))];
+    }
+    return aps;
+}
+
+/* scan reporting `size` access points, into an array resp. streamed to a callback */
+static void bench_scan(Context &ctx, unsigned size, bool stream)
+{
+    Result r("scan", stream ? "stream" : "array", 1, size);
+    std::vector<WiFiAccessPoint> res(size);
+
+    ctx.board.sim.set_scan_results(make_aps(size));
+    uint32_t overflows = mbed_host::uart_rx_overflows();
+    Measurement m(ctx, r);
+
+    for(unsigned n = 0; n < opts.iterations; n++) {
+        bench_clock::time_point t0 = bench_clock::now();
+        nsapi_size_or_error_t count;
+
+        if(stream) {
+            unsigned streamed = 0;
+            count = ctx.wifi.scan_stream(spwfsa_scan_cb_t([&streamed](const WiFiAccessPoint &) -> bool {
+                streamed++;
+                return true;
+            }));
+            if(count >= 0) count = streamed;
+        } else {
+            count = ctx.wifi.scan(&res[0], size);
+        }
+
+        if(count != (nsapi_size_or_error_t)size) r.errors++;
+        r.latencies_us.push_back(elapsed_us(t0)); // per scan
+        r.ops += (count > 0) ? count : 0;       // per AP
+    }
+    m.stop();
+
+    r.lost = mbed_host::uart_rx_overflows() - overflows;
+    ctx.board.sim.set_scan_results(Config().scan_results);
+    emit(r);
+}
+
+static std::vector<unsigned> sizes(unsigned s0, unsigned s1, unsigned s2, unsigned s3 = 0, unsigned s4 = 0)
+{
+    if(!opts.sizes.empty()) return opts.sizes;
+
+    unsigned all[] = { s0, s1, s2, s3, s4 };
+    std::vector<unsigned> ret;
+    for(unsigned i = 0; i < 5; i++) {
+        if(all[i] > 0) ret.push_back(all[i]);
+        if(opts.quick && (ret.size() == 2)) break;
+    }
+    return ret;
+}
+
+static bool selected(const char *bench)
+{
+    return std::find(opts.benches.begin(), opts.benches.end(), bench) != opts.benches.end();
+}
+
+static std::vector<unsigned> parse_list(const char *arg)
+{
+    std::vector<unsigned> values;
+    char *end;
+
+    for(const char *p = arg; *p != '\0'; p = (*end == ',') ? end + 1 : end) {
+        values.push_back((unsigned)strtoul(p, &end, 0));
+        if(end == p) break;
+    }
+    return values;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --bench <list>       benchmarks to run (default: all of tcp_up,tcp_down,udp_tx,udp_rx,rtt,open_close,scan)\n"
+            "  --sockets <list>     socket counts to sweep (1..8, default: 1,2,4,8)\n"
+            "  --sizes <list>       payload/read sizes (resp. number of APs for scan) to sweep (default: per benchmark)\n"
+            "  --bytes <n>          bytes transferred per run, split among the sockets (default: 32768)\n"
+            "  --iterations <n>     iterations of rtt, open_close & scan runs (default: 20)\n"
+            "  --cmd-latency <us>   AT command processing time of the simulated module (default: 0)\n"
+            "  --json               write JSON lines instead of CSV\n"
+            "  --no-header          omit CSV header\n"
+            "  --quick              small sweep (for testing the benchmarks themselves)\n",
+            prog);
+}
+
+static bool parse_options(int argc, char *argv[])
+{
+    opts.benches.assign(bench_names, bench_names + sizeof(bench_names) / sizeof(bench_names[0]));
+    opts.sockets = parse_list("1,2,4,8");
+    opts.bytes = 32768;
+    opts.iterations = 20;
+    opts.cmd_latency_us = 0;
+    opts.json = false;
+    opts.header = true;
+    opts.quick = false;
+
+    for(int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if(arg == "--json") {
+            opts.json = true;
+        } else if(arg == "--no-header") {
+            opts.header = false;
+        } else if(arg == "--quick") {
+            opts.quick = true;
+            opts.sockets = parse_list("1,2");
+            opts.bytes = 4096;
+            opts.iterations = 3;
+        } else if(value == NULL) {
+            return false;
+        } else if(arg == "--bench") {
+            opts.benches.clear();
+            for(const char *p = value; *p != '\0';) {
+                const char *comma = strchr(p, ',');
+                size_t len = comma ? (size_t)(comma - p) : strlen(p);
+                opts.benches.push_back(std::string(p, len));
+                p += len + (comma ? 1 : 0);
+            }
+            i++;
+        } else if(arg == "--sockets") {
+            opts.sockets = parse_list(value);
+            i++;
+        } else if(arg == "--sizes") {
+            opts.sizes = parse_list(value);
+            i++;
+        } else if(arg == "--bytes") {
+            opts.bytes = (unsigned)strtoul(value, NULL, 0);
+            i++;
+        } else if(arg == "--iterations") {
+            opts.iterations = (unsigned)strtoul(value, NULL, 0);
+            i++;
+        } else if(arg == "--cmd-latency") {
+            opts.cmd_latency_us = (unsigned)strtoul(value, NULL, 0);
+            i++;
+        } else {
+            return false;
+        }
+    }
+
+    for(size_t i = 0; i < opts.sockets.size(); i++) {
+        if((opts.sockets[i] < 1) || (opts.sockets[i] > SPWFSA_SOCKET_COUNT)) return false;
+    }
+    return (opts.bytes > 0) && (opts.iterations > 0);
+}
+
+int main(int argc, char *argv[])
+{
+    if(!parse_options(argc, argv)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    Config config = SimBoard::default_config();
+    config.cmd_latency_us = opts.cmd_latency_us;
+
+    LoopbackPeer peer;
+    SimBoard board(config);
+    SpwfSAInterface wifi;
+    Context ctx = { wifi, board, peer };
+
+    if(wifi.connect(config.ap_ssid.c_str(), config.ap_passphrase.c_str(), NSAPI_SECURITY_WPA2) != NSAPI_ERROR_OK) {
+        fprintf(stderr, "%s: failed to connect to the simulated access point\n", argv[0]);
+        _exit(1);
+    }
+
+    if(selected("tcp_up")) {
+        std::vector<const char *> variants = tx_variants();
+        std::vector<unsigned> sz = sizes(16, 64, 256, 730, 2048);
+        for(size_t v = 0; v < variants.size(); v++) {
+            for(size_t s = 0; s < opts.sockets.size(); s++) {
+                for(size_t i = 0; i < sz.size(); i++) bench_tcp_up(ctx, opts.sockets[s], sz[i], variants[v]);
+            }
+        }
+    }
+    if(selected("tcp_down")) {
+        std::vector<unsigned> sz = sizes(16, 64, 256, 730, 4096);
+        for(size_t s = 0; s < opts.sockets.size(); s++) {
+            for(size_t i = 0; i < sz.size(); i++) bench_tcp_down(ctx, opts.sockets[s], sz[i]);
+        }
+    }
+    if(selected("udp_tx")) {
+        std::vector<unsigned> sz = sizes(64, 256, 730);
+        for(size_t s = 0; s < opts.sockets.size(); s++) {
+            for(size_t i = 0; i < sz.size(); i++) bench_udp_tx(ctx, opts.sockets[s], sz[i]);
+        }
+    }
+    if(selected("udp_rx")) {
+        std::vector<unsigned> sz = sizes(64, 256, 730);
+        for(size_t s = 0; s < opts.sockets.size(); s++) {
+            for(size_t i = 0; i < sz.size(); i++) bench_udp_rx(ctx, opts.sockets[s], sz[i]);
+        }
+    }
+    if(selected("rtt")) {
+        std::vector<unsigned> sz = sizes(16, 256, 730);
+        for(size_t s = 0; s < opts.sockets.size(); s++) {
+            for(size_t i = 0; i < sz.size(); i++) bench_rtt(ctx, opts.sockets[s], sz[i]);
+        }
+    }
+    if(selected("open_close")) {
+        for(size_t s = 0; s < opts.sockets.size(); s++) bench_open_close(ctx, opts.sockets[s]);
+    }
+    if(selected("scan")) {
+        std::vector<unsigned> sz = sizes(10, 100, 300);
+        for(size_t i = 0; i < sz.size(); i++) {
+            bench_scan(ctx, sz[i], false);
+            bench_scan(ctx, sz[i], true);
+        }
+    }
+
+    wifi.disconnect();
+    fflush(stdout);
+
+    /* skip static destruction, the driver's threads are still running */
+    _exit((total_errors == 0) ? 0 : 1);
+}
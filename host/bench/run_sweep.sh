@@ -0,0 +1,25 @@
+#!/bin/sh
+# Run the benchmarks of all boards & console speeds built in a build directory and
+# merge their results into one file (CSV, resp. JSON lines with option `--json`)
+#
+# usage: run_sweep.sh <build dir> <output file> [benchmark options...]
+
+if [ $# -lt 2 ]; then
+    echo "usage: $0 <build dir> <output file> [benchmark options...]" >&2
+    exit 2
+fi
+
+build=$1
+output=$2
+shift 2
+
+header=""
+rc=0
+: > "$output"
+for bench in "$build"/spwf_bench_*; do
+    [ -x "$bench" ] || continue
+    echo "running $(basename "$bench") ..." >&2
+    "$bench" $header "$@" >> "$output" || rc=1
+    header="--no-header"
+done
+exit $rc
@@ -0,0 +1,285 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+
+#include "mbed_debug.h"
+#include "ATCmdParser.h"
+
+#define LF  10
+#define CR  13
+
+namespace mbed {
+
+ATCmdParser::ATCmdParser(FileHandle *fh, const char *output_delimiter, int buffer_size, int timeout, bool debug)
+: _fh(fh), _buffer_size(buffer_size), _timeout(timeout), _in_prev(0), _dbg_on(debug), _aborted(false), _oobs(NULL)
+{
+    _buffer = new char[buffer_size];
+    set_delimiter(output_delimiter);
+}
+
+ATCmdParser::~ATCmdParser()
+{
+    while(_oobs) {
+        oob_handler *o = _oobs;
+        _oobs = o->next;
+        delete o;
+    }
+    delete[] _buffer;
+}
+
+int ATCmdParser::putc(char c)
+{
+    pollfh fhs;
+    fhs.fh = _fh;
+    fhs.events = POLLOUT;
+
+    int count = poll(&fhs, 1, _timeout);
+    if((count > 0) && (fhs.revents & POLLOUT)) {
+        return (_fh->write(&c, 1) == 1) ? 0 : -1;
+    }
+    return -1;
+}
+
+int ATCmdParser::getc()
+{
+    pollfh fhs;
+    fhs.fh = _fh;
+    fhs.events = POLLIN;
+
+    int count = poll(&fhs, 1, _timeout);
+    if((count > 0) && (fhs.revents & POLLIN)) {
+        unsigned char ch;
+        return (_fh->read(&ch, 1) == 1) ? ch : -1;
+    }
+    return -1;
+}
+
+void ATCmdParser::flush()
+{
+    while(_fh->readable()) {
+        char ch;
+        _fh->read(&ch, 1);
+    }
+}
+
+int ATCmdParser::write(const char *data, int size)
+{
+    int i = 0;
+    for( ; i < size; i++) {
+        if(putc(data[i]) < 0) return -1;
+    }
+    return i;
+}
+
+int ATCmdParser::read(char *data, int size)
+{
+    int i = 0;
+    for( ; i < size; i++) {
+        int c = getc();
+        if(c < 0) return -1;
+        data[i] = c;
+    }
+    return i;
+}
+
+bool ATCmdParser::vsend(const char *command, va_list args)
+{
+    /* create and send command */
+    if(vsnprintf(_buffer, _buffer_size, command, args) < 0) return false;
+
+    for(int i = 0; _buffer[i]; i++) {
+        if(putc(_buffer[i]) < 0) return false;
+    }
+
+    /* finish with newline */
+    for(int i = 0; _output_delimiter[i]; i++) {
+        if(putc(_output_delimiter[i]) < 0) return false;
+    }
+
+    debug_if(_dbg_on, "AT> %s\n", _buffer);
+    return true;
+}
+
+bool ATCmdParser::send(const char *command, ...)
+{
+    va_list args;
+    va_start(args, command);
+    bool res = vsend(command, args);
+    va_end(args);
+    return res;
+}
+
+bool ATCmdParser::vrecv(const char *response, va_list args)
+{
+restart:
+    _aborted = false;
+    /* iterate through each line in the expected response */
+    while(response[0]) {
+        /* copy the line into our buffer, adding a null terminator and clobbering value-matches with asterisks */
+        int i = 0;
+        int offset = 0;
+        bool whole_line_wanted = false;
+
+        while(response[i]) {
+            if((response[i] == '%') && (response[i + 1] != '%') && (response[i + 1] != '*')) {
+                _buffer[offset++] = '%';
+                _buffer[offset++] = '*';
+                i++;
+            } else {
+                _buffer[offset++] = response[i++];
+                /* find linebreaks, taking care not to be fooled if they're in a %[^\n] conversion specification */
+                if((response[i - 1] == '\n') && !((i >= 3) && (response[i - 3] == '[') && (response[i - 2] == '^'))) {
+                    whole_line_wanted = true;
+                    break;
+                }
+            }
+        }
+
+        /* abuse the %n specifier to determine if the entire string was matched */
+        _buffer[offset++] = '%';
+        _buffer[offset++] = 'n';
+        _buffer[offset++] = 0;
+
+        debug_if(_dbg_on, "AT? %s\n", _buffer);
+
+        /* try the match until we succeed or some other error derails us */
+        int j = 0;
+
+        while(true) {
+            int c = getc();
+            if(c < 0) {
+                debug_if(_dbg_on, "AT(Timeout)\n");
+                return false;
+            }
+
+            /* simplify newlines */
+            if(((c == CR) && (_in_prev != LF)) ||
+                    ((c == LF) && (_in_prev != CR))) {
+                _in_prev = c;
+                c = '\n';
+            } else if(((c == CR) && (_in_prev == LF)) ||
+                      ((c == LF) && (_in_prev == CR))) {
+                _in_prev = c;
+                continue; // onto next character
+            } else {
+                _in_prev = c;
+            }
+            _buffer[offset + j++] = c;
+            _buffer[offset + j] = 0;
+
+            /* check for oob data */
+            for(oob_handler *o = _oobs; o; o = o->next) {
+                if(((unsigned)j == o->len) && (memcmp(o->prefix, _buffer + offset, o->len) == 0)) {
+                    debug_if(_dbg_on, "AT! %s\n", o->prefix);
+                    o->cb();
+
+                    if(_aborted) {
+                        debug_if(_dbg_on, "AT(Aborted)\n");
+                        return false;
+                    }
+                    /* oob may have corrupted non-reentrant buffer, so we need to set it up again */
+                    goto restart;
+                }
+            }
+
+            /* check for match */
+            int count = -1;
+            if(whole_line_wanted && (c != '\n')) {
+                /* don't attempt scanning until we get the delimiter if they included it in the format */
+            } else {
+                sscanf(_buffer + offset, _buffer, &count);
+            }
+
+            /* we only succeed if all characters in the response are matched */
+            if(count == j) {
+                debug_if(_dbg_on, "AT= %s\n", _buffer + offset);
+                /* reuse the front end of the buffer */
+                memcpy(_buffer, response, i);
+                _buffer[i] = 0;
+
+                /* store the found results */
+                vsscanf(_buffer + offset, _buffer, args);
+
+                /* jump to next line and continue parsing */
+                response += i;
+                break;
+            }
+
+            /* clear the buffer when we hit a newline or ran out of space (usually because of binary data) */
+            if((c == '\n') || (j + 1 >= _buffer_size - offset)) {
+                debug_if(_dbg_on, "AT< %s", _buffer + offset);
+                j = 0;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ATCmdParser::recv(const char *response, ...)
+{
+    va_list args;
+    va_start(args, response);
+    bool res = vrecv(response, args);
+    va_end(args);
+    return res;
+}
+
+void ATCmdParser::oob(const char *prefix, Callback<void()> cb)
+{
+    oob_handler *o = new oob_handler;
+    o->len = strlen(prefix);
+    o->prefix = prefix;
+    o->cb = cb;
+    o->next = _oobs;
+    _oobs = o;
+}
+
+void ATCmdParser::abort()
+{
+    _aborted = true;
+}
+
+bool ATCmdParser::process_oob()
+{
+    if(!_fh->readable()) return false;
+
+    int i = 0;
+    while(true) {
+        int c = getc();
+        if(c < 0) return false;
+
+        _buffer[i++] = c;
+        _buffer[i] = 0;
+
+        for(oob_handler *o = _oobs; o; o = o->next) {
+            if((i == (int)o->len) && (memcmp(o->prefix, _buffer, o->len) == 0)) {
+                debug_if(_dbg_on, "AT! %s\r\n", o->prefix);
+                o->cb();
+                return true;
+            }
+        }
+
+        /* clear the buffer when we hit a newline or ran out of space */
+        if(((i + 1) >= _buffer_size) || (c == '\n')) {
+            debug_if(_dbg_on, "AT< %s", _buffer);
+            i = 0;
+        }
+    }
+}
+
+} // namespace mbed
@@ -0,0 +1,96 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_ATCMDPARSER_H
+#define MBED_HOST_ATCMDPARSER_H
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "mbed_toolchain.h"
+#include "Callback.h"
+#include "FileHandle.h"
+
+namespace mbed {
+
+/* mbed 5.9 `ATCmdParser`, with the same line matching & out-of-band data semantics */
+class ATCmdParser {
+public:
+    ATCmdParser(FileHandle *fh, const char *output_delimiter = "\r",
+                int buffer_size = 256, int timeout = 8000, bool debug = false);
+    ~ATCmdParser();
+
+    void set_timeout(int timeout)
+    {
+        _timeout = timeout;
+    }
+
+    void set_delimiter(const char *output_delimiter)
+    {
+        _output_delimiter = output_delimiter;
+        _output_delim_size = strlen(output_delimiter);
+    }
+
+    void debug_on(uint8_t on)
+    {
+        _dbg_on = (on) ? 1 : 0;
+    }
+
+    bool send(const char *command, ...) MBED_PRINTF_METHOD(1, 2);
+    bool vsend(const char *command, va_list args);
+
+    bool recv(const char *response, ...) MBED_SCANF_METHOD(1, 2);
+    bool vrecv(const char *response, va_list args);
+
+    int putc(char c);
+    int getc();
+    int write(const char *data, int size);
+    int read(char *data, int size);
+    void flush();
+
+    void oob(const char *prefix, Callback<void()> func);
+    void abort();
+    bool process_oob(void);
+
+private:
+    ATCmdParser(const ATCmdParser &);
+    ATCmdParser &operator=(const ATCmdParser &);
+
+    FileHandle *_fh;
+
+    int _buffer_size;
+    char *_buffer;
+    int _timeout;
+
+    const char *_output_delimiter;
+    int _output_delim_size;
+    char _in_prev;
+    bool _dbg_on;
+    bool _aborted;
+
+    struct oob_handler {
+        unsigned len;
+        const char *prefix;
+        Callback<void()> cb;
+        oob_handler *next;
+    };
+    oob_handler *_oobs;
+};
+
+} // namespace mbed
+
+#endif // MBED_HOST_ATCMDPARSER_H
@@ -0,0 +1,115 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_CALLBACK_H
+#define MBED_HOST_CALLBACK_H
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#include "mbed_assert.h"
+
+namespace mbed {
+
+template <typename F>
+class Callback;
+
+/* Subset of mbed's `Callback` (function pointers, bound member functions & functors),
+ * backed by `std::function` instead of mbed's fixed size storage */
+template <typename R, typename... ArgTs>
+class Callback<R(ArgTs...)> {
+public:
+    Callback(R (*func)(ArgTs...) = 0)
+    {
+        if(func) _func = func;
+    }
+
+    template <typename T, typename U>
+    Callback(U *obj, R (T::*method)(ArgTs...))
+    {
+        _func = [obj, method](ArgTs... args) -> R { return (obj->*method)(args...); };
+    }
+
+    template <typename T, typename U>
+    Callback(const U *obj, R (T::*method)(ArgTs...) const)
+    {
+        _func = [obj, method](ArgTs... args) -> R { return (obj->*method)(args...); };
+    }
+
+    template <typename F, typename = typename std::enable_if<
+                  std::is_class<F>::value &&
+                  !std::is_same<typename std::decay<F>::type, Callback>::value>::type>
+    Callback(F f) : _func(f) {}
+
+    void attach(const Callback &func)
+    {
+        _func = func._func;
+    }
+
+    R call(ArgTs... args) const
+    {
+        MBED_ASSERT(_func);
+        return _func(args...);
+    }
+
+    R operator()(ArgTs... args) const
+    {
+        return call(args...);
+    }
+
+    operator bool() const
+    {
+        return static_cast<bool>(_func);
+    }
+
+    /* Static thunk for passing a callback through a `void *` context (as done by `NetworkStack::socket_attach()`) */
+    static R thunk(void *func, ArgTs... args)
+    {
+        return static_cast<Callback *>(func)->call(args...);
+    }
+
+private:
+    std::function<R(ArgTs...)> _func;
+};
+
+template <typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(R (*func)(ArgTs...))
+{
+    return Callback<R(ArgTs...)>(func);
+}
+
+template <typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(const Callback<R(ArgTs...)> &func)
+{
+    return func;
+}
+
+template <typename T, typename U, typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(U *obj, R (T::*method)(ArgTs...))
+{
+    return Callback<R(ArgTs...)>(obj, method);
+}
+
+template <typename T, typename U, typename R, typename... ArgTs>
+Callback<R(ArgTs...)> callback(const U *obj, R (T::*method)(ArgTs...) const)
+{
+    return Callback<R(ArgTs...)>(obj, method);
+}
+
+} // namespace mbed
+
+#endif // MBED_HOST_CALLBACK_H
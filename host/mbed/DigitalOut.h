@@ -0,0 +1,60 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_DIGITALOUT_H
+#define MBED_HOST_DIGITALOUT_H
+
+#include "PinNames.h"
+
+namespace mbed {
+
+/* Digital output, level changes get reported to the listener attached to the pin (see `mbed_host.h`) */
+class DigitalOut {
+public:
+    DigitalOut(PinName pin);
+    DigitalOut(PinName pin, int value);
+
+    void write(int value);
+
+    int read()
+    {
+        return _value;
+    }
+
+    int is_connected()
+    {
+        return _pin != NC;
+    }
+
+    DigitalOut &operator=(int value)
+    {
+        write(value);
+        return *this;
+    }
+
+    operator int()
+    {
+        return read();
+    }
+
+private:
+    PinName _pin;
+    int _value;
+};
+
+} // namespace mbed
+
+#endif // MBED_HOST_DIGITALOUT_H
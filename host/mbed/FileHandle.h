@@ -0,0 +1,81 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_FILEHANDLE_H
+#define MBED_HOST_FILEHANDLE_H
+
+#include <errno.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "Callback.h"
+#include "mbed_poll.h"
+
+namespace mbed {
+
+/* mbed 5.9 `FileHandle` interface */
+class FileHandle {
+public:
+    virtual ~FileHandle() {}
+
+    virtual ssize_t read(void *buffer, size_t size) = 0;
+    virtual ssize_t write(const void *buffer, size_t size) = 0;
+    virtual off_t seek(off_t offset, int whence = SEEK_SET) = 0;
+    virtual int close() = 0;
+
+    virtual int sync()
+    {
+        return 0;
+    }
+
+    virtual int isatty()
+    {
+        return 0;
+    }
+
+    virtual int set_blocking(bool blocking)
+    {
+        return blocking ? 0 : -ENOTTY;
+    }
+
+    virtual bool is_blocking() const
+    {
+        return true;
+    }
+
+    virtual short poll(short events) const
+    {
+        return POLLIN | POLLOUT;
+    }
+
+    bool writable() const
+    {
+        return poll(POLLOUT) & POLLOUT;
+    }
+
+    bool readable() const
+    {
+        return poll(POLLIN) & POLLIN;
+    }
+
+    virtual void sigio(Callback<void()> func)
+    {
+    }
+};
+
+} // namespace mbed
+
+#endif // MBED_HOST_FILEHANDLE_H
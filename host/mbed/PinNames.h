@@ -0,0 +1,60 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_PINNAMES_H
+#define MBED_HOST_PINNAMES_H
+
+/* Pins of a virtual NUCLEO board (Arduino & Morpho headers), they just serve as keys for
+ * connecting UARTs & GPIOs to the host side (see `mbed_host.h`) */
+typedef enum {
+    PA_0 = 0x00, PA_1, PA_2, PA_3, PA_4, PA_5, PA_6, PA_7,
+    PA_8, PA_9, PA_10, PA_11, PA_12, PA_13, PA_14, PA_15,
+    PB_0 = 0x10, PB_1, PB_2, PB_3, PB_4, PB_5, PB_6, PB_7,
+    PB_8, PB_9, PB_10, PB_11, PB_12, PB_13, PB_14, PB_15,
+    PC_0 = 0x20, PC_1, PC_2, PC_3, PC_4, PC_5, PC_6, PC_7,
+    PC_8, PC_9, PC_10, PC_11, PC_12, PC_13, PC_14, PC_15,
+
+    /* Arduino connector namings (NUCLEO-F401RE) */
+    A0 = PA_0,
+    A1 = PA_1,
+    A2 = PA_4,
+    A3 = PB_0,
+    A4 = PC_1,
+    A5 = PC_0,
+    D0 = PA_3,
+    D1 = PA_2,
+    D2 = PA_10,
+    D3 = PB_3,
+    D4 = PB_5,
+    D5 = PB_4,
+    D6 = PB_10,
+    D7 = PA_8,
+    D8 = PA_9,
+    D9 = PC_7,
+    D10 = PB_6,
+    D11 = PA_7,
+    D12 = PA_6,
+    D13 = PA_5,
+    D14 = PB_9,
+    D15 = PB_8,
+
+    USBTX = PA_2,
+    USBRX = PA_3,
+
+    NC = (int)0xFFFFFFFF
+} PinName;
+
+#endif // MBED_HOST_PINNAMES_H
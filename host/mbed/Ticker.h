@@ -0,0 +1,64 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_TICKER_H
+#define MBED_HOST_TICKER_H
+
+#include <chrono>
+
+#include "Callback.h"
+
+namespace mbed {
+
+/* Periodic callback, executed in "interrupt" context (see `mbed_critical.h`) by a dispatcher thread
+ * which serves all tickers & timeouts */
+class Ticker {
+public:
+    Ticker();
+    virtual ~Ticker();
+
+    void attach(Callback<void()> func, float t)
+    {
+        attach_us(func, static_cast<uint32_t>(t * 1000000.0f));
+    }
+
+    void attach_us(Callback<void()> func, uint32_t t);
+
+    void detach();
+
+protected:
+    friend class TickerDispatcher;
+
+    virtual void handler();
+
+    bool _periodic;
+    uint32_t _delay_us;
+    std::chrono::steady_clock::time_point _deadline;
+    Callback<void()> _function;
+};
+
+/* One-shot callback */
+class Timeout : public Ticker {
+public:
+    Timeout()
+    {
+        _periodic = false;
+    }
+};
+
+} // namespace mbed
+
+#endif // MBED_HOST_TICKER_H
@@ -0,0 +1,55 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_TIMER_H
+#define MBED_HOST_TIMER_H
+
+#include <chrono>
+
+#include "us_ticker_api.h"
+
+namespace mbed {
+
+/* Stopwatch based on the monotonic clock of the host */
+class Timer {
+public:
+    Timer();
+
+    void start();
+    void stop();
+    void reset();
+
+    float read();
+    int read_ms();
+    int read_us();
+    us_timestamp_t read_high_resolution_us();
+
+    operator float()
+    {
+        return read();
+    }
+
+private:
+    typedef std::chrono::steady_clock clock;
+
+    bool _running;
+    clock::time_point _start;
+    clock::duration _time;
+};
+
+} // namespace mbed
+
+#endif // MBED_HOST_TIMER_H
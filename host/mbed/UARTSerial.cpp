@@ -0,0 +1,342 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "mbed_critical.h"
+#include "mbed_error.h"
+#include "mbed_host.h"
+#include "UARTSerial.h"
+
+namespace mbed {
+
+static speed_t baud_to_speed(int baud)
+{
+    switch(baud) {
+        case 9600:      return B9600;
+        case 19200:     return B19200;
+        case 38400:     return B38400;
+        case 57600:     return B57600;
+        case 115200:    return B115200;
+        case 230400:    return B230400;
+        case 460800:    return B460800;
+        case 921600:    return B921600;
+        default:
+            error("UARTSerial: unsupported baud rate %d\n", baud);
+    }
+}
+
+UARTSerial::UARTSerial(PinName tx, PinName rx, int baud)
+: _fd(-1), _baud(baud), _blocking(true), _flow_control(false), _closing(false), _tx_busy(false)
+{
+    const char *device = mbed_host::uart_device(tx, rx);
+
+    if(device == NULL) {
+        error("UARTSerial: no tty attached to pins %d/%d\n", tx, rx);
+    }
+
+    _fd = ::open(device, O_RDWR | O_NOCTTY);
+    if(_fd < 0) {
+        error("UARTSerial: cannot open %s\n", device);
+    }
+    if(::pipe(_wake_fd) != 0) {
+        error("UARTSerial: cannot create pipe\n");
+    }
+
+    _configure_tty();
+    ::tcflush(_fd, TCIOFLUSH); // nothing has been received before the UART got initialized
+
+    _rx_thread = std::thread(&UARTSerial::_rx_thread_loop, this);
+    _tx_thread = std::thread(&UARTSerial::_tx_thread_loop, this);
+}
+
+UARTSerial::~UARTSerial()
+{
+    close();
+}
+
+int UARTSerial::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_closing) return 0;
+        _closing = true;
+    }
+    _rx_cv.notify_all();
+    _tx_cv.notify_all();
+    _wake_rx_thread();
+    if(_rx_thread.joinable()) _rx_thread.join();
+    if(_tx_thread.joinable()) _tx_thread.join();
+    ::close(_wake_fd[0]);
+    ::close(_wake_fd[1]);
+    ::close(_fd);
+    return 0;
+}
+
+void UARTSerial::_configure_tty()
+{
+    struct termios tio;
+
+    if(::tcgetattr(_fd, &tio) != 0) {
+        error("UARTSerial: not a tty\n");
+    }
+    ::cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    ::cfsetispeed(&tio, baud_to_speed(_baud));
+    ::cfsetospeed(&tio, baud_to_speed(_baud));
+    ::tcsetattr(_fd, TCSANOW, &tio);
+}
+
+void UARTSerial::_wake_rx_thread()
+{
+    char c = 0;
+    if(::write(_wake_fd[1], &c, 1) < 0) {
+        /* pipe full, reader gets woken up anyway */
+    }
+}
+
+void UARTSerial::set_baud(int baud)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _baud = baud;
+    _configure_tty();
+}
+
+void UARTSerial::set_format(int bits, Parity parity, int stop_bits)
+{
+    /* the simulated link always uses 8N1 */
+}
+
+void UARTSerial::set_flow_control(Flow type, PinName flow1, PinName flow2)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _flow_control = (type != Disabled);
+    }
+    _rx_cv.notify_all();
+    _wake_rx_thread();
+}
+
+/* RX "IRQ": move received bytes into the RX ring */
+void UARTSerial::_rx_thread_loop()
+{
+    unsigned char buf[64];
+
+    while(true) {
+        size_t room = sizeof(buf);
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if(_flow_control) { // keep RTS deasserted (i.e. stop reading from the tty) while the ring is full
+                while(!_closing && _flow_control && (_rxbuf.size() >= MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE)) {
+                    _rx_cv.wait(lock);
+                }
+                if(_flow_control) {
+                    size_t space = MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE - _rxbuf.size();
+                    if(space < room) room = space;
+                }
+            }
+            if(_closing) return;
+        }
+
+        struct pollfd fds[2];
+        fds[0].fd = _fd;
+        fds[0].events = POLLIN;
+        fds[1].fd = _wake_fd[0];
+        fds[1].events = POLLIN;
+        if(::poll(fds, 2, -1) <= 0) continue;
+
+        if(fds[1].revents & POLLIN) {
+            char c;
+            if(::read(_wake_fd[0], &c, 1) < 0) {
+                /* nothing to do */
+            }
+            continue;
+        }
+        if(fds[0].revents & (POLLERR | POLLHUP)) {
+            usleep(1000); // other side closed, wait for it to come back (or for `close()`)
+            continue;
+        }
+
+        ssize_t n = ::read(_fd, buf, room);
+        if(n <= 0) continue;
+
+        bool was_empty;
+        uint32_t dropped = 0;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            was_empty = _rxbuf.empty();
+            for(ssize_t i = 0; i < n; i++) {
+                if(_rxbuf.size() < MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE) {
+                    _rxbuf.push_back(buf[i]);
+                } else {
+                    dropped++;
+                }
+            }
+        }
+        if(dropped > 0) mbed_host::uart_rx_overflow(dropped);
+
+        _rx_cv.notify_all();
+        poll_notify();
+
+        if(was_empty) {
+            mbed_host::IrqContext irq;
+            if(_sigio_cb) _sigio_cb();
+        }
+    }
+}
+
+/* TX "IRQ": move the content of the TX ring out to the tty */
+void UARTSerial::_tx_thread_loop()
+{
+    unsigned char buf[MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE];
+
+    while(true) {
+        size_t n;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while(!_closing && _txbuf.empty()) _tx_cv.wait(lock);
+            if(_closing) return;
+            n = _txbuf.size();
+            if(n > sizeof(buf)) n = sizeof(buf);
+            std::copy(_txbuf.begin(), _txbuf.begin() + n, buf);
+            _txbuf.erase(_txbuf.begin(), _txbuf.begin() + n);
+            _tx_busy = true;
+        }
+        _tx_cv.notify_all();
+        poll_notify();
+
+        size_t written = 0;
+        while(written < n) {
+            ssize_t ret = ::write(_fd, buf + written, n - written);
+            if(ret < 0) {
+                if(errno == EINTR || errno == EAGAIN) continue;
+                break; // drop data for a tty without reader (i.e. a module which has been switched off)
+            }
+            written += ret;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tx_busy = false;
+        }
+        _tx_cv.notify_all();
+    }
+}
+
+ssize_t UARTSerial::write(const void *buffer, size_t length)
+{
+    const unsigned char *data = static_cast<const unsigned char *>(buffer);
+    size_t copied = 0;
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while(copied < length) {
+            while(!_closing && (_txbuf.size() >= MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE)) {
+                if(!_blocking) break;
+                _tx_cv.wait(lock);
+            }
+            if(_closing) return -EBADF;
+            if(_txbuf.size() >= MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE) break; // non-blocking
+            while((copied < length) && (_txbuf.size() < MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE)) {
+                _txbuf.push_back(data[copied++]);
+            }
+            _tx_cv.notify_all();
+        }
+    }
+
+    return (copied > 0) ? copied : -EAGAIN;
+}
+
+ssize_t UARTSerial::read(void *buffer, size_t length)
+{
+    unsigned char *data = static_cast<unsigned char *>(buffer);
+    size_t n = 0;
+    bool was_full;
+
+    if(length == 0) return 0;
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while(!_closing && _blocking && _rxbuf.empty()) _rx_cv.wait(lock);
+        if(_rxbuf.empty()) return _closing ? -EBADF : -EAGAIN;
+
+        was_full = (_rxbuf.size() >= MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE);
+        while((n < length) && !_rxbuf.empty()) {
+            data[n++] = _rxbuf.front();
+            _rxbuf.pop_front();
+        }
+    }
+    if(was_full) _rx_cv.notify_all();
+
+    return n;
+}
+
+off_t UARTSerial::seek(off_t offset, int whence)
+{
+    return -ESPIPE;
+}
+
+int UARTSerial::sync()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while(!_closing && (!_txbuf.empty() || _tx_busy)) _tx_cv.wait(lock);
+    return 0;
+}
+
+int UARTSerial::isatty()
+{
+    return 1;
+}
+
+int UARTSerial::set_blocking(bool blocking)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _blocking = blocking;
+    return 0;
+}
+
+bool UARTSerial::is_blocking() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _blocking;
+}
+
+short UARTSerial::poll(short events) const
+{
+    short revents = 0;
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if(!_rxbuf.empty()) revents |= POLLIN;
+    if(_txbuf.size() < MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE) revents |= POLLOUT;
+
+    return revents & events;
+}
+
+void UARTSerial::sigio(Callback<void()> func)
+{
+    CriticalSectionLock lock;
+
+    _sigio_cb = func;
+    if(_sigio_cb) {
+        if(poll(0x7FFF)) _sigio_cb();
+    }
+}
+
+} // namespace mbed
@@ -0,0 +1,95 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_UARTSERIAL_H
+#define MBED_HOST_UARTSERIAL_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "PinNames.h"
+#include "FileHandle.h"
+#include "SerialBase.h"
+
+#ifndef MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE
+#define MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE  256
+#endif
+#ifndef MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE
+#define MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE  256
+#endif
+#ifndef MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE
+#define MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE 9600
+#endif
+
+namespace mbed {
+
+/* Buffered serial port on top of the tty attached to the pins (see `mbed_host.h`).
+ *
+ * As on the target, received bytes go into an RX ring of `MBED_CONF_DRIVERS_UART_SERIAL_RXBUF_SIZE` bytes
+ * (filled by a reader thread standing in for the RX IRQ) and get dropped when it is full, unless RTS/CTS
+ * flow control has been enabled; `sigio()` callbacks are called in "interrupt" context whenever data
+ * arrives in the empty ring. Writes go through a TX ring of `MBED_CONF_DRIVERS_UART_SERIAL_TXBUF_SIZE` bytes. */
+class UARTSerial : public FileHandle, public SerialBase {
+public:
+    UARTSerial(PinName tx, PinName rx, int baud = MBED_CONF_PLATFORM_DEFAULT_SERIAL_BAUD_RATE);
+    virtual ~UARTSerial();
+
+    virtual ssize_t write(const void *buffer, size_t length);
+    virtual ssize_t read(void *buffer, size_t length);
+    virtual off_t seek(off_t offset, int whence);
+    virtual int close();
+    virtual int sync();
+    virtual int isatty();
+    virtual int set_blocking(bool blocking);
+    virtual bool is_blocking() const;
+    virtual short poll(short events) const;
+    virtual void sigio(Callback<void()> func);
+
+    void set_baud(int baud);
+    void set_format(int bits = 8, Parity parity = UARTSerial::None, int stop_bits = 1);
+    void set_flow_control(Flow type, PinName flow1 = NC, PinName flow2 = NC);
+
+private:
+    void _configure_tty();
+    void _wake_rx_thread();
+    void _rx_thread_loop();
+    void _tx_thread_loop();
+
+    int _fd;
+    int _wake_fd[2];
+    int _baud;
+    bool _blocking;
+    bool _flow_control;
+    bool _closing;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _rx_cv;   // data in RX ring resp. space in RX ring (flow control)
+    std::condition_variable _tx_cv;   // data in TX ring resp. space in TX ring & TX ring drained
+    std::deque<unsigned char> _rxbuf;
+    std::deque<unsigned char> _txbuf;
+    bool _tx_busy;                    // TX thread writing out data taken from `_txbuf`
+
+    Callback<void()> _sigio_cb;       // protected by critical section
+
+    std::thread _rx_thread;
+    std::thread _tx_thread;
+};
+
+} // namespace mbed
+
+#endif // MBED_HOST_UARTSERIAL_H
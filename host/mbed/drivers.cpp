@@ -0,0 +1,202 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "mbed_critical.h"
+#include "mbed_host.h"
+#include "DigitalOut.h"
+#include "Ticker.h"
+#include "Timer.h"
+
+namespace mbed {
+
+Timer::Timer() : _running(false), _time(clock::duration::zero())
+{
+}
+
+void Timer::start()
+{
+    if(!_running) {
+        _start = clock::now();
+        _running = true;
+    }
+}
+
+void Timer::stop()
+{
+    if(_running) {
+        _time += clock::now() - _start;
+        _running = false;
+    }
+}
+
+void Timer::reset()
+{
+    _start = clock::now();
+    _time = clock::duration::zero();
+}
+
+us_timestamp_t Timer::read_high_resolution_us()
+{
+    clock::duration time = _time;
+    if(_running) time += clock::now() - _start;
+    return std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+}
+
+float Timer::read()
+{
+    return read_high_resolution_us() / 1000000.0f;
+}
+
+int Timer::read_ms()
+{
+    return static_cast<int>(read_high_resolution_us() / 1000);
+}
+
+int Timer::read_us()
+{
+    return static_cast<int>(read_high_resolution_us());
+}
+
+/* Thread executing expired tickers in "interrupt" context.
+ * Lock order: "interrupt" lock, then `_mutex` */
+class TickerDispatcher {
+public:
+    static TickerDispatcher &instance()
+    {
+        static TickerDispatcher *dispatcher = new TickerDispatcher(); // never destroyed, as the thread keeps running
+        return *dispatcher;
+    }
+
+    /* both to be called within a critical section */
+    void insert(Ticker *ticker)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.insert(std::make_pair(ticker->_deadline, ticker));
+        _cv.notify_one();
+    }
+
+    void remove(Ticker *ticker)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for(queue_t::iterator it = _queue.begin(); it != _queue.end(); ++it) {
+            if(it->second == ticker) {
+                _queue.erase(it);
+                return;
+            }
+        }
+    }
+
+private:
+    typedef std::multimap<std::chrono::steady_clock::time_point, Ticker *> queue_t;
+
+    TickerDispatcher() : _thread(&TickerDispatcher::_loop, this)
+    {
+        _thread.detach();
+    }
+
+    void _loop()
+    {
+        while(true) {
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if(_queue.empty()) {
+                    _cv.wait(lock);
+                } else {
+                    _cv.wait_until(lock, _queue.begin()->first);
+                }
+            }
+
+            mbed_host::IrqContext irq;
+            Ticker *expired = NULL;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if(!_queue.empty() && (_queue.begin()->first <= std::chrono::steady_clock::now())) {
+                    expired = _queue.begin()->second;
+                    _queue.erase(_queue.begin());
+                }
+            }
+            if(expired != NULL) expired->handler();
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    queue_t _queue;
+    std::thread _thread;
+};
+
+Ticker::Ticker() : _periodic(true), _delay_us(0)
+{
+}
+
+Ticker::~Ticker()
+{
+    detach();
+}
+
+void Ticker::attach_us(Callback<void()> func, uint32_t t)
+{
+    CriticalSectionLock lock;
+
+    TickerDispatcher::instance().remove(this);
+    _function = func;
+    _delay_us = t;
+    _deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(t);
+    if(_function) TickerDispatcher::instance().insert(this);
+}
+
+void Ticker::detach()
+{
+    CriticalSectionLock lock;
+
+    TickerDispatcher::instance().remove(this);
+    _function = NULL;
+}
+
+void Ticker::handler()
+{
+    Callback<void()> function = _function;
+
+    if(_periodic) {
+        _deadline += std::chrono::microseconds(_delay_us);
+        TickerDispatcher::instance().insert(this);
+    } else {
+        _function = NULL;
+    }
+    if(function) function();
+}
+
+DigitalOut::DigitalOut(PinName pin) : _pin(pin), _value(0)
+{
+}
+
+DigitalOut::DigitalOut(PinName pin, int value) : _pin(pin), _value(value)
+{
+    if(_pin != NC) mbed_host::gpio_write(_pin, _value);
+}
+
+void DigitalOut::write(int value)
+{
+    _value = value;
+    if(_pin != NC) mbed_host::gpio_write(_pin, _value);
+}
+
+} // namespace mbed
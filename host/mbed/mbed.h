@@ -0,0 +1,56 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_H
+#define MBED_H
+
+/* Subset of mbed OS 5.9 needed by the driver, implemented on top of POSIX so that the driver can be built
+ * & tested on a Linux host (see `host/README.md`) */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mbed_toolchain.h"
+#include "mbed_assert.h"
+#include "mbed_error.h"
+#include "mbed_debug.h"
+#include "mbed_critical.h"
+#include "mbed_wait_api.h"
+#include "us_ticker_api.h"
+#include "PinNames.h"
+#include "Callback.h"
+
+#include "DigitalOut.h"
+#include "Timer.h"
+#include "Ticker.h"
+#include "FileHandle.h"
+#include "UARTSerial.h"
+
+#ifndef MBED_CONF_RTOS_PRESENT
+#define MBED_CONF_RTOS_PRESENT 1
+#endif
+#if MBED_CONF_RTOS_PRESENT
+#include "rtos/rtos.h"
+#endif
+
+#include "netsocket/nsapi.h"
+
+using namespace mbed;
+
+#endif // MBED_H
@@ -0,0 +1,53 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_H
+#define MBED_HOST_H
+
+#include <stdint.h>
+
+#include "PinNames.h"
+#include "Callback.h"
+
+/* Host side wiring of the virtual board, to be done before constructing the driver */
+namespace mbed_host {
+
+/* Connect the UART on pins `tx`/`rx` to the tty `device` (e.g. the slave side of a simulator's pty) */
+void attach_uart(PinName tx, PinName rx, const char *device);
+
+/* tty attached to pins `tx`/`rx` (NULL if none) */
+const char *uart_device(PinName tx, PinName rx);
+
+/* Get called with every level written to `pin` by a `DigitalOut` */
+void attach_gpio(PinName pin, mbed::Callback<void(int)> func);
+
+/* Report `value` written to `pin` */
+void gpio_write(PinName pin, int value);
+
+/* Number of bytes dropped so far because of a full UART RX ring */
+uint32_t uart_rx_overflows(void);
+void uart_rx_overflow(uint32_t bytes);
+
+/* Execution of an "interrupt" handler by a host thread: masks all other "interrupts" & critical sections */
+class IrqContext {
+public:
+    IrqContext();
+    ~IrqContext();
+};
+
+} // namespace mbed_host
+
+#endif // MBED_HOST_H
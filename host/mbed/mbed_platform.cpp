@@ -0,0 +1,226 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "mbed_assert.h"
+#include "mbed_critical.h"
+#include "mbed_error.h"
+#include "mbed_host.h"
+#include "mbed_poll.h"
+#include "mbed_wait_api.h"
+#include "us_ticker_api.h"
+#include "FileHandle.h"
+
+/* Platform services of the host build */
+
+typedef std::chrono::steady_clock host_clock;
+
+static const host_clock::time_point startup_time = host_clock::now();
+
+/* global "interrupt" lock (see `mbed_critical.h`) */
+static std::recursive_mutex &irq_lock()
+{
+    static std::recursive_mutex lock;
+    return lock;
+}
+
+static thread_local unsigned int critical_depth = 0;
+static thread_local bool isr_active = false;
+
+extern "C" void mbed_assert_internal(const char *expr, const char *file, int line)
+{
+    fprintf(stderr, "mbed assertation failed: %s, file: %s, line %d \n", expr, file, line);
+    abort();
+}
+
+extern "C" void error(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vfprintf(stderr, format, args);
+    va_end(args);
+    abort();
+}
+
+extern "C" void core_util_critical_section_enter(void)
+{
+    irq_lock().lock();
+    critical_depth++;
+}
+
+extern "C" void core_util_critical_section_exit(void)
+{
+    MBED_ASSERT(critical_depth > 0);
+    critical_depth--;
+    irq_lock().unlock();
+}
+
+extern "C" bool core_util_in_critical_section(void)
+{
+    return (critical_depth > 0);
+}
+
+extern "C" bool core_util_is_isr_active(void)
+{
+    return isr_active;
+}
+
+extern "C" void wait(float s)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(s * 1000000.0f)));
+}
+
+extern "C" void wait_ms(int ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+extern "C" void wait_us(int us)
+{
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+extern "C" uint32_t us_ticker_read(void)
+{
+    return static_cast<uint32_t>(ticker_read_us(get_us_ticker_data()));
+}
+
+extern "C" const ticker_data_t *get_us_ticker_data(void)
+{
+    return NULL;
+}
+
+extern "C" us_timestamp_t ticker_read_us(const ticker_data_t *const ticker)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(host_clock::now() - startup_time).count();
+}
+
+namespace mbed {
+
+static std::mutex poll_mutex;
+static std::condition_variable poll_cv;
+static uint64_t poll_generation = 0;
+
+void poll_notify()
+{
+    std::lock_guard<std::mutex> lock(poll_mutex);
+    poll_generation++;
+    poll_cv.notify_all();
+}
+
+/* unlike mbed's busy polling, sleep until a file handle reports a state change */
+int poll(pollfh fhs[], unsigned nfds, int timeout)
+{
+    host_clock::time_point deadline = host_clock::now() + std::chrono::milliseconds(timeout > 0 ? timeout : 0);
+    std::unique_lock<std::mutex> lock(poll_mutex);
+
+    while(true) {
+        uint64_t generation = poll_generation;
+        int count = 0;
+
+        lock.unlock();
+        for(unsigned n = 0; n < nfds; n++) {
+            short mask = fhs[n].events | POLLERR | POLLHUP | POLLNVAL;
+            fhs[n].revents = (fhs[n].fh != NULL) ? (fhs[n].fh->poll(mask) & mask) : 0;
+            if(fhs[n].revents) count++;
+        }
+        lock.lock();
+
+        if((count > 0) || (timeout == 0)) return count;
+        if(generation != poll_generation) continue;
+
+        if(timeout < 0) {
+            poll_cv.wait(lock);
+        } else if(poll_cv.wait_until(lock, deadline) == std::cv_status::timeout) {
+            if(generation == poll_generation) return 0;
+        }
+    }
+}
+
+} // namespace mbed
+
+namespace mbed_host {
+
+static std::mutex wiring_mutex;
+static std::map<std::pair<int, int>, std::string> uarts;
+static std::map<int, mbed::Callback<void(int)> > gpios;
+static uint32_t rx_overflows = 0;
+
+void attach_uart(PinName tx, PinName rx, const char *device)
+{
+    std::lock_guard<std::mutex> lock(wiring_mutex);
+    uarts[std::make_pair(static_cast<int>(tx), static_cast<int>(rx))] = device;
+}
+
+const char *uart_device(PinName tx, PinName rx)
+{
+    std::lock_guard<std::mutex> lock(wiring_mutex);
+    std::map<std::pair<int, int>, std::string>::const_iterator it =
+        uarts.find(std::make_pair(static_cast<int>(tx), static_cast<int>(rx)));
+    return (it != uarts.end()) ? it->second.c_str() : NULL;
+}
+
+void attach_gpio(PinName pin, mbed::Callback<void(int)> func)
+{
+    std::lock_guard<std::mutex> lock(wiring_mutex);
+    gpios[pin] = func;
+}
+
+void gpio_write(PinName pin, int value)
+{
+    mbed::Callback<void(int)> func;
+    {
+        std::lock_guard<std::mutex> lock(wiring_mutex);
+        std::map<int, mbed::Callback<void(int)> >::const_iterator it = gpios.find(pin);
+        if(it == gpios.end()) return;
+        func = it->second;
+    }
+    if(func) func(value);
+}
+
+uint32_t uart_rx_overflows(void)
+{
+    return __atomic_load_n(&rx_overflows, __ATOMIC_SEQ_CST);
+}
+
+void uart_rx_overflow(uint32_t bytes)
+{
+    __atomic_add_fetch(&rx_overflows, bytes, __ATOMIC_SEQ_CST);
+}
+
+IrqContext::IrqContext()
+{
+    core_util_critical_section_enter();
+    isr_active = true;
+}
+
+IrqContext::~IrqContext()
+{
+    isr_active = false;
+    core_util_critical_section_exit();
+}
+
+} // namespace mbed_host
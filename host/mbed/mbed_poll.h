@@ -0,0 +1,40 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_POLL_H
+#define MBED_HOST_POLL_H
+
+#include <poll.h>
+
+namespace mbed {
+
+class FileHandle;
+
+struct pollfh {
+    FileHandle *fh;
+    short events;
+    short revents;
+};
+
+/* Wait (at most `timeout` ms, or forever if negative) for events on mbed file handles */
+int poll(pollfh fhs[], unsigned nfds, int timeout);
+
+/* Host build: wake up threads blocked in `poll()` after the state of a file handle has changed */
+void poll_notify();
+
+} // namespace mbed
+
+#endif // MBED_HOST_POLL_H
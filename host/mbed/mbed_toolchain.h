@@ -0,0 +1,39 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_TOOLCHAIN_H
+#define MBED_HOST_TOOLCHAIN_H
+
+#define MBED_MAJOR_VERSION 5
+#define MBED_MINOR_VERSION 9
+#define MBED_PATCH_VERSION 0
+
+#define MBED_ENCODE_VERSION(major, minor, patch) ((major)*10000 + (minor)*100 + (patch))
+#define MBED_VERSION MBED_ENCODE_VERSION(MBED_MAJOR_VERSION, MBED_MINOR_VERSION, MBED_PATCH_VERSION)
+
+#define MBED_UNUSED             __attribute__((__unused__))
+#define MBED_NORETURN           __attribute__((noreturn))
+#define MBED_PRINTF(f, a)       __attribute__((format(__printf__, f, a)))
+#define MBED_PRINTF_METHOD(f, a) __attribute__((format(__printf__, f+1, a+1)))
+#define MBED_SCANF_METHOD(f, a)  __attribute__((format(__scanf__, f+1, a+1)))
+#define MBED_DEPRECATED(M)      __attribute__((deprecated(M)))
+
+/* target capabilities relevant to the driver */
+#define DEVICE_SERIAL           1
+#define DEVICE_SERIAL_FC        1
+#define DEVICE_STDIO_MESSAGES   1
+
+#endif // MBED_HOST_TOOLCHAIN_H
@@ -0,0 +1,67 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_NETWORKINTERFACE_H
+#define MBED_HOST_NETWORKINTERFACE_H
+
+#include <stdint.h>
+
+#include "Callback.h"
+#include "nsapi_types.h"
+#include "SocketAddress.h"
+#include "NetworkStack.h"
+
+/* mbed 5.9 `NetworkInterface` */
+class NetworkInterface {
+public:
+    virtual ~NetworkInterface() {}
+
+    virtual const char *get_mac_address();
+    virtual const char *get_ip_address();
+    virtual const char *get_netmask();
+    virtual const char *get_gateway();
+
+    virtual nsapi_error_t set_network(const char *ip_address, const char *netmask, const char *gateway);
+    virtual nsapi_error_t set_dhcp(bool dhcp);
+
+    virtual nsapi_error_t connect() = 0;
+    virtual nsapi_error_t disconnect() = 0;
+
+    virtual nsapi_error_t gethostbyname(const char *host, SocketAddress *address, nsapi_version_t version = NSAPI_UNSPEC);
+    virtual nsapi_error_t add_dns_server(const SocketAddress &address);
+
+    virtual void attach(mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb);
+    virtual nsapi_connection_status_t get_connection_status() const;
+    virtual nsapi_error_t set_blocking(bool blocking);
+
+protected:
+    friend class Socket;
+    friend class UDPSocket;
+    friend class TCPSocket;
+
+    template <typename IF>
+    friend NetworkStack *nsapi_create_stack(IF *iface);
+
+    virtual NetworkStack *get_stack() = 0;
+};
+
+template <typename IF>
+NetworkStack *nsapi_create_stack(IF *iface)
+{
+    return nsapi_create_stack(static_cast<NetworkInterface *>(iface)->get_stack());
+}
+
+#endif // MBED_HOST_NETWORKINTERFACE_H
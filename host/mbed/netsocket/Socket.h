@@ -0,0 +1,72 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_SOCKET_H
+#define MBED_HOST_SOCKET_H
+
+#include "Callback.h"
+#include "rtos/Mutex.h"
+#include "rtos/EventFlags.h"
+#include "NetworkStack.h"
+#include "NetworkInterface.h"
+#include "SocketAddress.h"
+
+/* mbed 5.9 `Socket` */
+class Socket {
+public:
+    virtual ~Socket() {}
+
+    nsapi_error_t open(NetworkStack *stack);
+
+    template <typename S>
+    nsapi_error_t open(S *stack)
+    {
+        return open(nsapi_create_stack(stack));
+    }
+
+    nsapi_error_t close();
+
+    nsapi_error_t bind(uint16_t port);
+    nsapi_error_t bind(const char *address, uint16_t port);
+    nsapi_error_t bind(const SocketAddress &address);
+
+    void set_blocking(bool blocking);
+    void set_timeout(int timeout);
+
+    nsapi_error_t setsockopt(int level, int optname, const void *optval, unsigned optlen);
+    nsapi_error_t getsockopt(int level, int optname, void *optval, unsigned *optlen);
+
+    void sigio(mbed::Callback<void()> func);
+
+protected:
+    Socket();
+
+    virtual nsapi_protocol_t get_proto() = 0;
+    virtual void event() = 0;
+
+    NetworkStack *_stack;
+    nsapi_socket_t _socket;
+    uint32_t _timeout;
+    mbed::Callback<void()> _event;
+    mbed::Callback<void()> _callback;
+    rtos::Mutex _lock;
+
+    static const int READ_FLAG     = 0x1u;
+    static const int WRITE_FLAG    = 0x2u;
+    static const int FINISHED_FLAG = 0x3u;
+};
+
+#endif // MBED_HOST_SOCKET_H
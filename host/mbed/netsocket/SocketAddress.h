@@ -0,0 +1,53 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_SOCKETADDRESS_H
+#define MBED_HOST_SOCKETADDRESS_H
+
+#include "nsapi_types.h"
+
+/* IP address & port */
+class SocketAddress {
+public:
+    SocketAddress(nsapi_addr_t addr = nsapi_addr_t(), uint16_t port = 0);
+    SocketAddress(const char *addr, uint16_t port = 0);
+    SocketAddress(const void *bytes, nsapi_version_t version, uint16_t port = 0);
+    SocketAddress(const SocketAddress &addr);
+
+    bool set_ip_address(const char *addr);
+    void set_ip_bytes(const void *bytes, nsapi_version_t version);
+    void set_addr(nsapi_addr_t addr);
+    void set_port(uint16_t port);
+
+    const char *get_ip_address() const;
+    const void *get_ip_bytes() const;
+    nsapi_version_t get_ip_version() const;
+    nsapi_addr_t get_addr() const;
+    uint16_t get_port() const;
+
+    operator bool() const;
+    SocketAddress &operator=(const SocketAddress &addr);
+
+    friend bool operator==(const SocketAddress &a, const SocketAddress &b);
+    friend bool operator!=(const SocketAddress &a, const SocketAddress &b);
+
+private:
+    mutable char _ip_address[NSAPI_IP_SIZE];
+    nsapi_addr_t _addr;
+    uint16_t _port;
+};
+
+#endif // MBED_HOST_SOCKETADDRESS_H
@@ -0,0 +1,51 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_TCPSOCKET_H
+#define MBED_HOST_TCPSOCKET_H
+
+#include "Socket.h"
+
+/* mbed 5.9 `TCPSocket` (client side) */
+class TCPSocket : public Socket {
+public:
+    TCPSocket();
+
+    template <typename S>
+    TCPSocket(S *stack) : _pending(0), _read_in_progress(false), _write_in_progress(false)
+    {
+        open(stack);
+    }
+
+    virtual ~TCPSocket();
+
+    nsapi_error_t connect(const char *host, uint16_t port);
+    nsapi_error_t connect(const SocketAddress &address);
+
+    nsapi_size_or_error_t send(const void *data, nsapi_size_t size);
+    nsapi_size_or_error_t recv(void *data, nsapi_size_t size);
+
+protected:
+    virtual nsapi_protocol_t get_proto();
+    virtual void event();
+
+    volatile unsigned _pending;
+    rtos::EventFlags _event_flag;
+    bool _read_in_progress;
+    bool _write_in_progress;
+};
+
+#endif // MBED_HOST_TCPSOCKET_H
@@ -0,0 +1,47 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_UDPSOCKET_H
+#define MBED_HOST_UDPSOCKET_H
+
+#include "Socket.h"
+
+/* mbed 5.9 `UDPSocket` */
+class UDPSocket : public Socket {
+public:
+    UDPSocket();
+
+    template <typename S>
+    UDPSocket(S *stack) : _pending(0)
+    {
+        open(stack);
+    }
+
+    virtual ~UDPSocket();
+
+    nsapi_size_or_error_t sendto(const char *host, uint16_t port, const void *data, nsapi_size_t size);
+    nsapi_size_or_error_t sendto(const SocketAddress &address, const void *data, nsapi_size_t size);
+    nsapi_size_or_error_t recvfrom(SocketAddress *address, void *data, nsapi_size_t size);
+
+protected:
+    virtual nsapi_protocol_t get_proto();
+    virtual void event();
+
+    volatile unsigned _pending;
+    rtos::EventFlags _event_flag;
+};
+
+#endif // MBED_HOST_UDPSOCKET_H
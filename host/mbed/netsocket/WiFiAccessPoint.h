@@ -0,0 +1,62 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_WIFIACCESSPOINT_H
+#define MBED_HOST_WIFIACCESSPOINT_H
+
+#include <string.h>
+
+#include "nsapi_types.h"
+
+class WiFiAccessPoint {
+public:
+    WiFiAccessPoint()
+    {
+        memset(&_ap, 0, sizeof(_ap));
+    }
+
+    WiFiAccessPoint(nsapi_wifi_ap_t ap) : _ap(ap) {}
+
+    const char *get_ssid() const
+    {
+        return _ap.ssid;
+    }
+
+    const uint8_t *get_bssid() const
+    {
+        return _ap.bssid;
+    }
+
+    nsapi_security_t get_security() const
+    {
+        return _ap.security;
+    }
+
+    int8_t get_rssi() const
+    {
+        return _ap.rssi;
+    }
+
+    uint8_t get_channel() const
+    {
+        return _ap.channel;
+    }
+
+private:
+    nsapi_wifi_ap_t _ap;
+};
+
+#endif // MBED_HOST_WIFIACCESSPOINT_H
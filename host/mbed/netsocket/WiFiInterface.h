@@ -0,0 +1,40 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_WIFIINTERFACE_H
+#define MBED_HOST_WIFIINTERFACE_H
+
+#include "NetworkInterface.h"
+#include "WiFiAccessPoint.h"
+
+class WiFiInterface : public NetworkInterface {
+public:
+    virtual nsapi_error_t set_credentials(const char *ssid, const char *pass,
+                                          nsapi_security_t security = NSAPI_SECURITY_NONE) = 0;
+    virtual nsapi_error_t set_channel(uint8_t channel) = 0;
+    virtual int8_t get_rssi() = 0;
+
+    virtual nsapi_error_t connect(const char *ssid, const char *pass,
+                                  nsapi_security_t security = NSAPI_SECURITY_NONE, uint8_t channel = 0) = 0;
+    virtual nsapi_error_t connect() = 0;
+    virtual nsapi_error_t disconnect() = 0;
+
+    virtual nsapi_size_or_error_t scan(WiFiAccessPoint *res, nsapi_size_t count) = 0;
+
+    static WiFiInterface *get_default_instance();
+};
+
+#endif // MBED_HOST_WIFIINTERFACE_H
@@ -0,0 +1,625 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <arpa/inet.h>
+#include <string.h>
+
+#include "mbed_assert.h"
+#include "netsocket/nsapi.h"
+
+/* SocketAddress */
+
+SocketAddress::SocketAddress(nsapi_addr_t addr, uint16_t port)
+{
+    _ip_address[0] = '\0';
+    set_addr(addr);
+    set_port(port);
+}
+
+SocketAddress::SocketAddress(const char *addr, uint16_t port)
+{
+    _ip_address[0] = '\0';
+    memset(&_addr, 0, sizeof(_addr));
+    set_ip_address(addr);
+    set_port(port);
+}
+
+SocketAddress::SocketAddress(const void *bytes, nsapi_version_t version, uint16_t port)
+{
+    _ip_address[0] = '\0';
+    set_ip_bytes(bytes, version);
+    set_port(port);
+}
+
+SocketAddress::SocketAddress(const SocketAddress &addr)
+{
+    _ip_address[0] = '\0';
+    set_addr(addr.get_addr());
+    set_port(addr.get_port());
+}
+
+bool SocketAddress::set_ip_address(const char *addr)
+{
+    _ip_address[0] = '\0';
+    memset(&_addr, 0, sizeof(_addr));
+
+    if(addr && (inet_pton(AF_INET, addr, _addr.bytes) == 1)) {
+        _addr.version = NSAPI_IPv4;
+        return true;
+    }
+    if(addr && (inet_pton(AF_INET6, addr, _addr.bytes) == 1)) {
+        _addr.version = NSAPI_IPv6;
+        return true;
+    }
+    _addr.version = NSAPI_UNSPEC;
+    return false;
+}
+
+void SocketAddress::set_ip_bytes(const void *bytes, nsapi_version_t version)
+{
+    nsapi_addr_t addr;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.version = version;
+    if(version == NSAPI_IPv6) {
+        memcpy(addr.bytes, bytes, NSAPI_IPv6_BYTES);
+    } else if(version == NSAPI_IPv4) {
+        memcpy(addr.bytes, bytes, NSAPI_IPv4_BYTES);
+    }
+    set_addr(addr);
+}
+
+void SocketAddress::set_addr(nsapi_addr_t addr)
+{
+    _ip_address[0] = '\0';
+    _addr = addr;
+}
+
+void SocketAddress::set_port(uint16_t port)
+{
+    _port = port;
+}
+
+const char *SocketAddress::get_ip_address() const
+{
+    if(_addr.version == NSAPI_UNSPEC) return NULL;
+
+    if(!_ip_address[0]) {
+        inet_ntop((_addr.version == NSAPI_IPv4) ? AF_INET : AF_INET6, _addr.bytes, _ip_address, sizeof(_ip_address));
+    }
+    return _ip_address;
+}
+
+const void *SocketAddress::get_ip_bytes() const
+{
+    return _addr.bytes;
+}
+
+nsapi_version_t SocketAddress::get_ip_version() const
+{
+    return _addr.version;
+}
+
+nsapi_addr_t SocketAddress::get_addr() const
+{
+    return _addr;
+}
+
+uint16_t SocketAddress::get_port() const
+{
+    return _port;
+}
+
+SocketAddress::operator bool() const
+{
+    if(_addr.version == NSAPI_IPv4) {
+        return (memcmp(_addr.bytes, "\0\0\0\0", NSAPI_IPv4_BYTES) != 0);
+    } else if(_addr.version == NSAPI_IPv6) {
+        static const uint8_t zero[NSAPI_IPv6_BYTES] = { 0 };
+        return (memcmp(_addr.bytes, zero, NSAPI_IPv6_BYTES) != 0);
+    }
+    return false;
+}
+
+SocketAddress &SocketAddress::operator=(const SocketAddress &addr)
+{
+    set_addr(addr.get_addr());
+    set_port(addr.get_port());
+    return *this;
+}
+
+bool operator==(const SocketAddress &a, const SocketAddress &b)
+{
+    if(!a && !b) return true;
+    if(a._addr.version != b._addr.version) return false;
+    if(a._addr.version == NSAPI_IPv4) {
+        return (memcmp(a._addr.bytes, b._addr.bytes, NSAPI_IPv4_BYTES) == 0);
+    }
+    return (memcmp(a._addr.bytes, b._addr.bytes, NSAPI_IPv6_BYTES) == 0);
+}
+
+bool operator!=(const SocketAddress &a, const SocketAddress &b)
+{
+    return !(a == b);
+}
+
+/* NetworkStack */
+
+const char *NetworkStack::get_ip_address()
+{
+    return NULL;
+}
+
+nsapi_error_t NetworkStack::gethostbyname(const char *host, SocketAddress *address, nsapi_version_t version)
+{
+    if(address->set_ip_address(host)) {
+        if((version != NSAPI_UNSPEC) && (address->get_ip_version() != version)) {
+            return NSAPI_ERROR_DNS_FAILURE;
+        }
+        return NSAPI_ERROR_OK;
+    }
+    return NSAPI_ERROR_DNS_FAILURE; // no DNS client in the host build
+}
+
+nsapi_error_t NetworkStack::add_dns_server(const SocketAddress &address)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::setstackopt(int level, int optname, const void *optval, unsigned optlen)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::getstackopt(int level, int optname, void *optval, unsigned *optlen)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::setsockopt(nsapi_socket_t handle, int level, int optname, const void *optval, unsigned optlen)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkStack::getsockopt(nsapi_socket_t handle, int level, int optname, void *optval, unsigned *optlen)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+/* NetworkInterface */
+
+const char *NetworkInterface::get_mac_address()
+{
+    return 0;
+}
+
+const char *NetworkInterface::get_ip_address()
+{
+    return 0;
+}
+
+const char *NetworkInterface::get_netmask()
+{
+    return 0;
+}
+
+const char *NetworkInterface::get_gateway()
+{
+    return 0;
+}
+
+nsapi_error_t NetworkInterface::set_network(const char *ip_address, const char *netmask, const char *gateway)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkInterface::set_dhcp(bool dhcp)
+{
+    return dhcp ? NSAPI_ERROR_OK : NSAPI_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkInterface::gethostbyname(const char *host, SocketAddress *address, nsapi_version_t version)
+{
+    return get_stack()->gethostbyname(host, address, version);
+}
+
+nsapi_error_t NetworkInterface::add_dns_server(const SocketAddress &address)
+{
+    return get_stack()->add_dns_server(address);
+}
+
+void NetworkInterface::attach(mbed::Callback<void(nsapi_event_t, intptr_t)> status_cb)
+{
+}
+
+nsapi_connection_status_t NetworkInterface::get_connection_status() const
+{
+    return NSAPI_STATUS_ERROR_UNSUPPORTED;
+}
+
+nsapi_error_t NetworkInterface::set_blocking(bool blocking)
+{
+    return NSAPI_ERROR_UNSUPPORTED;
+}
+
+/* Socket */
+
+Socket::Socket() : _stack(0), _socket(0), _timeout(osWaitForever)
+{
+}
+
+nsapi_error_t Socket::open(NetworkStack *stack)
+{
+    _lock.lock();
+
+    if((_stack != NULL) || (stack == NULL)) {
+        _lock.unlock();
+        return NSAPI_ERROR_PARAMETER;
+    }
+    _stack = stack;
+
+    nsapi_socket_t socket;
+    nsapi_error_t err = _stack->socket_open(&socket, get_proto());
+    if(err) {
+        _stack = NULL;
+        _lock.unlock();
+        return err;
+    }
+
+    _socket = socket;
+    _event = mbed::callback(this, &Socket::event);
+    _stack->socket_attach(_socket, mbed::Callback<void()>::thunk, &_event);
+
+    _lock.unlock();
+    return NSAPI_ERROR_OK;
+}
+
+nsapi_error_t Socket::close()
+{
+    _lock.lock();
+
+    nsapi_error_t ret = NSAPI_ERROR_OK;
+    if(_socket) {
+        _stack->socket_attach(_socket, 0, 0);
+        nsapi_socket_t socket = _socket;
+        _socket = 0;
+        ret = _stack->socket_close(socket);
+    }
+    _stack = NULL; // allow reopening
+
+    /* wakeup anything in a blocking operation on this socket */
+    event();
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t Socket::bind(uint16_t port)
+{
+    SocketAddress addr;
+    addr.set_port(port);
+    return bind(addr);
+}
+
+nsapi_error_t Socket::bind(const char *address, uint16_t port)
+{
+    SocketAddress addr(address, port);
+    return bind(addr);
+}
+
+nsapi_error_t Socket::bind(const SocketAddress &address)
+{
+    _lock.lock();
+    nsapi_error_t ret = _socket ? _stack->socket_bind(_socket, address) : NSAPI_ERROR_NO_SOCKET;
+    _lock.unlock();
+    return ret;
+}
+
+void Socket::set_blocking(bool blocking)
+{
+    set_timeout(blocking ? -1 : 0);
+}
+
+void Socket::set_timeout(int timeout)
+{
+    _lock.lock();
+    _timeout = (timeout >= 0) ? static_cast<uint32_t>(timeout) : osWaitForever;
+    _lock.unlock();
+}
+
+nsapi_error_t Socket::setsockopt(int level, int optname, const void *optval, unsigned optlen)
+{
+    _lock.lock();
+    nsapi_error_t ret = _socket ? _stack->setsockopt(_socket, level, optname, optval, optlen) : NSAPI_ERROR_NO_SOCKET;
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t Socket::getsockopt(int level, int optname, void *optval, unsigned *optlen)
+{
+    _lock.lock();
+    nsapi_error_t ret = _socket ? _stack->getsockopt(_socket, level, optname, optval, optlen) : NSAPI_ERROR_NO_SOCKET;
+    _lock.unlock();
+    return ret;
+}
+
+void Socket::sigio(mbed::Callback<void()> func)
+{
+    _lock.lock();
+    _callback = func;
+    _lock.unlock();
+}
+
+/* TCPSocket */
+
+TCPSocket::TCPSocket() : _pending(0), _read_in_progress(false), _write_in_progress(false)
+{
+}
+
+TCPSocket::~TCPSocket()
+{
+    close();
+}
+
+nsapi_protocol_t TCPSocket::get_proto()
+{
+    return NSAPI_TCP;
+}
+
+nsapi_error_t TCPSocket::connect(const SocketAddress &address)
+{
+    _lock.lock();
+    nsapi_error_t ret;
+
+    /* if this assert is hit then there are two threads performing a send at the same time */
+    MBED_ASSERT(!_write_in_progress);
+    _write_in_progress = true;
+
+    bool blocking_connect_in_progress = false;
+
+    while(true) {
+        if(!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_connect(_socket, address);
+        if((_timeout == 0) || !((ret == NSAPI_ERROR_IN_PROGRESS) || (ret == NSAPI_ERROR_ALREADY))) {
+            break;
+        }
+
+        blocking_connect_in_progress = true;
+
+        /* release lock before blocking so other threads accessing this object aren't blocked */
+        _lock.unlock();
+        uint32_t flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+        _lock.lock();
+        if(flag & osFlagsError) break; // timeout
+    }
+
+    _event_flag.set(FINISHED_FLAG);
+    _write_in_progress = false;
+
+    /* non-blocking connect gives "EISCONN" once done - convert to OK for blocking mode */
+    if((ret == NSAPI_ERROR_IS_CONNECTED) && blocking_connect_in_progress) ret = NSAPI_ERROR_OK;
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_error_t TCPSocket::connect(const char *host, uint16_t port)
+{
+    SocketAddress address;
+
+    if(!_socket) return NSAPI_ERROR_NO_SOCKET;
+
+    nsapi_error_t err = _stack->gethostbyname(host, &address);
+    if(err) return NSAPI_ERROR_DNS_FAILURE;
+
+    address.set_port(port);
+    return connect(address);
+}
+
+nsapi_size_or_error_t TCPSocket::send(const void *data, nsapi_size_t size)
+{
+    _lock.lock();
+    const uint8_t *data_ptr = static_cast<const uint8_t *>(data);
+    nsapi_size_or_error_t ret;
+    nsapi_size_t written = 0;
+
+    /* if this assert is hit then there are two threads performing a send at the same time */
+    MBED_ASSERT(!_write_in_progress);
+    _write_in_progress = true;
+
+    /* unlike recv, we should write the whole thing if blocking */
+    while(true) {
+        if(!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_send(_socket, data_ptr + written, size - written);
+        if(ret >= 0) {
+            written += ret;
+            if(written >= size) break;
+        }
+
+        if(_timeout == 0) {
+            break;
+        } else if(ret == NSAPI_ERROR_WOULD_BLOCK) {
+            _lock.unlock();
+            uint32_t flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+            _lock.lock();
+            if(flag & osFlagsError) break; // timeout
+        } else if(ret < 0) {
+            break;
+        }
+    }
+
+    _event_flag.set(FINISHED_FLAG);
+    _write_in_progress = false;
+    _lock.unlock();
+
+    if((ret <= 0) && (ret != NSAPI_ERROR_WOULD_BLOCK)) {
+        return ret;
+    } else if(written == 0) {
+        return NSAPI_ERROR_WOULD_BLOCK;
+    }
+    return written;
+}
+
+nsapi_size_or_error_t TCPSocket::recv(void *data, nsapi_size_t size)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    /* if this assert is hit then there are two threads performing a recv at the same time */
+    MBED_ASSERT(!_read_in_progress);
+    _read_in_progress = true;
+
+    while(true) {
+        if(!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        ret = _stack->socket_recv(_socket, data, size);
+        if((_timeout == 0) || (ret != NSAPI_ERROR_WOULD_BLOCK)) break;
+
+        _lock.unlock();
+        uint32_t flag = _event_flag.wait_any(READ_FLAG, _timeout);
+        _lock.lock();
+        if(flag & osFlagsError) { // timeout
+            ret = NSAPI_ERROR_WOULD_BLOCK;
+            break;
+        }
+    }
+
+    _event_flag.set(FINISHED_FLAG);
+    _read_in_progress = false;
+    _lock.unlock();
+    return ret;
+}
+
+void TCPSocket::event()
+{
+    _event_flag.set(READ_FLAG | WRITE_FLAG);
+
+    _pending += 1;
+    if(_callback && (_pending == 1)) _callback();
+}
+
+/* UDPSocket */
+
+UDPSocket::UDPSocket() : _pending(0)
+{
+}
+
+UDPSocket::~UDPSocket()
+{
+    close();
+}
+
+nsapi_protocol_t UDPSocket::get_proto()
+{
+    return NSAPI_UDP;
+}
+
+nsapi_size_or_error_t UDPSocket::sendto(const char *host, uint16_t port, const void *data, nsapi_size_t size)
+{
+    SocketAddress address;
+
+    if(!_socket) return NSAPI_ERROR_NO_SOCKET;
+
+    nsapi_size_or_error_t err = _stack->gethostbyname(host, &address);
+    if(err) return NSAPI_ERROR_DNS_FAILURE;
+
+    address.set_port(port);
+    return sendto(address, data, size);
+}
+
+nsapi_size_or_error_t UDPSocket::sendto(const SocketAddress &address, const void *data, nsapi_size_t size)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    while(true) {
+        if(!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        nsapi_size_or_error_t sent = _stack->socket_sendto(_socket, address, data, size);
+        if((_timeout == 0) || (sent != NSAPI_ERROR_WOULD_BLOCK)) {
+            ret = sent;
+            break;
+        }
+
+        _lock.unlock();
+        uint32_t flag = _event_flag.wait_any(WRITE_FLAG, _timeout);
+        _lock.lock();
+        if(flag & osFlagsError) { // timeout
+            ret = NSAPI_ERROR_WOULD_BLOCK;
+            break;
+        }
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+nsapi_size_or_error_t UDPSocket::recvfrom(SocketAddress *address, void *buffer, nsapi_size_t size)
+{
+    _lock.lock();
+    nsapi_size_or_error_t ret;
+
+    while(true) {
+        if(!_socket) {
+            ret = NSAPI_ERROR_NO_SOCKET;
+            break;
+        }
+
+        _pending = 0;
+        nsapi_size_or_error_t recv = _stack->socket_recvfrom(_socket, address, buffer, size);
+        if((_timeout == 0) || (recv != NSAPI_ERROR_WOULD_BLOCK)) {
+            ret = recv;
+            break;
+        }
+
+        _lock.unlock();
+        uint32_t flag = _event_flag.wait_any(READ_FLAG, _timeout);
+        _lock.lock();
+        if(flag & osFlagsError) { // timeout
+            ret = NSAPI_ERROR_WOULD_BLOCK;
+            break;
+        }
+    }
+
+    _lock.unlock();
+    return ret;
+}
+
+void UDPSocket::event()
+{
+    _event_flag.set(READ_FLAG | WRITE_FLAG);
+
+    _pending += 1;
+    if(_callback && (_pending == 1)) _callback();
+}
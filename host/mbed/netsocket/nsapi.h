@@ -0,0 +1,30 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_NSAPI_H
+#define MBED_HOST_NSAPI_H
+
+#include "netsocket/nsapi_types.h"
+#include "netsocket/SocketAddress.h"
+#include "netsocket/NetworkStack.h"
+#include "netsocket/NetworkInterface.h"
+#include "netsocket/WiFiAccessPoint.h"
+#include "netsocket/WiFiInterface.h"
+#include "netsocket/Socket.h"
+#include "netsocket/TCPSocket.h"
+#include "netsocket/UDPSocket.h"
+
+#endif // MBED_HOST_NSAPI_H
@@ -0,0 +1,51 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_EVENTFLAGS_H
+#define MBED_HOST_EVENTFLAGS_H
+
+#include <condition_variable>
+#include <mutex>
+
+#include "mbed_rtos_types.h"
+
+namespace rtos {
+
+class EventFlags {
+public:
+    EventFlags() : _flags(0) {}
+    EventFlags(const char *name) : _flags(0) {}
+
+    uint32_t set(uint32_t flags);
+    uint32_t clear(uint32_t flags = 0x7fffffff);
+    uint32_t get() const;
+    uint32_t wait_all(uint32_t flags = 0, uint32_t timeout = osWaitForever, bool clear = true);
+    uint32_t wait_any(uint32_t flags = 0, uint32_t timeout = osWaitForever, bool clear = true);
+
+private:
+    EventFlags(const EventFlags &);
+    EventFlags &operator=(const EventFlags &);
+
+    uint32_t _wait(uint32_t flags, bool all, uint32_t timeout, bool clear);
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;
+    uint32_t _flags;
+};
+
+} // namespace rtos
+
+#endif // MBED_HOST_EVENTFLAGS_H
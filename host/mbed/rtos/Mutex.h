@@ -0,0 +1,46 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_MUTEX_H
+#define MBED_HOST_MUTEX_H
+
+#include <mutex>
+
+#include "mbed_rtos_types.h"
+
+namespace rtos {
+
+/* Recursive mutex (as mbed's `Mutex`) */
+class Mutex {
+public:
+    Mutex() {}
+    Mutex(const char *name) {}
+
+    osStatus lock(uint32_t millisec = osWaitForever);
+    bool trylock();
+    bool trylock_for(uint32_t millisec);
+    osStatus unlock();
+
+private:
+    Mutex(const Mutex &);
+    Mutex &operator=(const Mutex &);
+
+    std::recursive_timed_mutex _mutex;
+};
+
+} // namespace rtos
+
+#endif // MBED_HOST_MUTEX_H
@@ -0,0 +1,44 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_SCOPEDLOCK_H
+#define MBED_HOST_SCOPEDLOCK_H
+
+namespace rtos {
+
+template <typename Lockable>
+class ScopedLock {
+public:
+    ScopedLock(Lockable &lockable) : _lockable(lockable)
+    {
+        _lockable.lock();
+    }
+
+    ~ScopedLock()
+    {
+        _lockable.unlock();
+    }
+
+private:
+    ScopedLock(const ScopedLock &);
+    ScopedLock &operator=(const ScopedLock &);
+
+    Lockable &_lockable;
+};
+
+} // namespace rtos
+
+#endif // MBED_HOST_SCOPEDLOCK_H
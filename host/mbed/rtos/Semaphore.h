@@ -0,0 +1,48 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_SEMAPHORE_H
+#define MBED_HOST_SEMAPHORE_H
+
+#include <condition_variable>
+#include <mutex>
+
+#include "mbed_rtos_types.h"
+
+namespace rtos {
+
+class Semaphore {
+public:
+    Semaphore(int32_t count = 0);
+    Semaphore(int32_t count, uint16_t max_count);
+
+    /* number of available tokens before taking one, or 0 on timeout */
+    int32_t wait(uint32_t millisec = osWaitForever);
+    osStatus release(void);
+
+private:
+    Semaphore(const Semaphore &);
+    Semaphore &operator=(const Semaphore &);
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    int32_t _count;
+    int32_t _max_count;
+};
+
+} // namespace rtos
+
+#endif // MBED_HOST_SEMAPHORE_H
@@ -0,0 +1,49 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_THREAD_H
+#define MBED_HOST_THREAD_H
+
+#include <thread>
+
+#include "Callback.h"
+#include "mbed_rtos_types.h"
+
+namespace rtos {
+
+/* Thread backed by a host thread; priority & stack settings are ignored */
+class Thread {
+public:
+    Thread(osPriority priority = osPriorityNormal, uint32_t stack_size = OS_STACK_SIZE,
+           unsigned char *stack_mem = NULL, const char *name = NULL) {}
+    ~Thread();
+
+    osStatus start(mbed::Callback<void()> task);
+    osStatus join();
+
+    static osStatus wait(uint32_t millisec);
+    static osStatus yield();
+
+private:
+    Thread(const Thread &);
+    Thread &operator=(const Thread &);
+
+    std::thread _thread;
+};
+
+} // namespace rtos
+
+#endif // MBED_HOST_THREAD_H
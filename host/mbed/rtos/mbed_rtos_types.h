@@ -0,0 +1,56 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_RTOS_TYPES_H
+#define MBED_HOST_RTOS_TYPES_H
+
+#include <stdint.h>
+
+/* CMSIS-RTOS2 types & constants used by the mbed 5.9 RTOS API */
+typedef enum {
+    osOK                      =  0,
+    osError                   = -1,
+    osErrorTimeout            = -2,
+    osErrorResource           = -3,
+    osErrorParameter          = -4,
+    osErrorNoMemory           = -5,
+    osErrorISR                = -6
+} osStatus_t;
+
+typedef int32_t osStatus;
+
+typedef enum {
+    osPriorityIdle            =  1,
+    osPriorityLow             =  8,
+    osPriorityBelowNormal     = 16,
+    osPriorityNormal          = 24,
+    osPriorityAboveNormal     = 32,
+    osPriorityHigh            = 40,
+    osPriorityRealtime        = 48
+} osPriority_t;
+
+typedef osPriority_t osPriority;
+
+#define osWaitForever         0xFFFFFFFFU
+#define osFlagsError          0x80000000U
+#define osFlagsErrorTimeout   0xFFFFFFFEU
+#define osFlagsErrorResource  0xFFFFFFFDU
+
+#ifndef OS_STACK_SIZE
+#define OS_STACK_SIZE         4096
+#endif
+
+#endif // MBED_HOST_RTOS_TYPES_H
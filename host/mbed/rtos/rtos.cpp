@@ -0,0 +1,167 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+
+#include "mbed_assert.h"
+#include "rtos/rtos.h"
+
+namespace rtos {
+
+static std::chrono::milliseconds to_ms(uint32_t millisec)
+{
+    return std::chrono::milliseconds(millisec);
+}
+
+osStatus Mutex::lock(uint32_t millisec)
+{
+    if(millisec == osWaitForever) {
+        _mutex.lock();
+        return osOK;
+    }
+    return _mutex.try_lock_for(to_ms(millisec)) ? osOK : osErrorTimeout;
+}
+
+bool Mutex::trylock()
+{
+    return _mutex.try_lock();
+}
+
+bool Mutex::trylock_for(uint32_t millisec)
+{
+    return (lock(millisec) == osOK);
+}
+
+osStatus Mutex::unlock()
+{
+    _mutex.unlock();
+    return osOK;
+}
+
+Semaphore::Semaphore(int32_t count) : _count(count), _max_count(0xffff)
+{
+}
+
+Semaphore::Semaphore(int32_t count, uint16_t max_count) : _count(count), _max_count(max_count)
+{
+}
+
+int32_t Semaphore::wait(uint32_t millisec)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    if(millisec == osWaitForever) {
+        while(_count == 0) _cv.wait(lock);
+    } else if(!_cv.wait_for(lock, to_ms(millisec), [this] { return _count > 0; })) {
+        return 0;
+    }
+    return _count--;
+}
+
+osStatus Semaphore::release(void)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if(_count >= _max_count) return osErrorResource;
+    _count++;
+    _cv.notify_one();
+    return osOK;
+}
+
+uint32_t EventFlags::set(uint32_t flags)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _flags |= flags;
+    _cv.notify_all();
+    return _flags;
+}
+
+uint32_t EventFlags::clear(uint32_t flags)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    uint32_t old = _flags;
+    _flags &= ~flags;
+    return old;
+}
+
+uint32_t EventFlags::get() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _flags;
+}
+
+uint32_t EventFlags::wait_all(uint32_t flags, uint32_t timeout, bool clear)
+{
+    return _wait(flags, true, timeout, clear);
+}
+
+uint32_t EventFlags::wait_any(uint32_t flags, uint32_t timeout, bool clear)
+{
+    return _wait(flags, false, timeout, clear);
+}
+
+uint32_t EventFlags::_wait(uint32_t flags, bool all, uint32_t timeout, bool clear)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto ready = [this, flags, all] { return all ? ((_flags & flags) == flags) : ((_flags & flags) != 0); };
+
+    if(timeout == osWaitForever) {
+        _cv.wait(lock, ready);
+    } else if(!_cv.wait_for(lock, to_ms(timeout), ready)) {
+        return osFlagsErrorTimeout;
+    }
+
+    uint32_t result = _flags;
+    if(clear) _flags &= ~flags;
+    return result;
+}
+
+Thread::~Thread()
+{
+    /* driver threads run forever, let them go */
+    if(_thread.joinable()) _thread.detach();
+}
+
+osStatus Thread::start(mbed::Callback<void()> task)
+{
+    if(_thread.joinable()) return osErrorParameter;
+
+    _thread = std::thread([task] { task(); });
+    return osOK;
+}
+
+osStatus Thread::join()
+{
+    if(!_thread.joinable()) return osErrorParameter;
+    _thread.join();
+    return osOK;
+}
+
+osStatus Thread::wait(uint32_t millisec)
+{
+    std::this_thread::sleep_for(to_ms(millisec));
+    return osOK;
+}
+
+osStatus Thread::yield()
+{
+    std::this_thread::yield();
+    return osOK;
+}
+
+} // namespace rtos
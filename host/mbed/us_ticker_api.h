@@ -0,0 +1,41 @@
+/* SPWFSAxx Devices - mbed OS host shim
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MBED_HOST_US_TICKER_API_H
+#define MBED_HOST_US_TICKER_API_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint64_t us_timestamp_t;
+
+/* Opaque in the host build, all tickers are backed by the monotonic clock of the host */
+typedef struct ticker_data_s ticker_data_t;
+
+/* Microseconds since startup of the process (wrapping around after ~71 minutes) */
+uint32_t us_ticker_read(void);
+
+const ticker_data_t *get_us_ticker_data(void);
+us_timestamp_t ticker_read_us(const ticker_data_t *const ticker);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MBED_HOST_US_TICKER_API_H
@@ -0,0 +1,330 @@
+/* SPWFSAxx Devices - module simulator
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "LoopbackPeer.h"
+
+namespace spwf_sim {
+
+static void set_nonblocking(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+}
+
+/* bind a socket of `type` to an ephemeral port on 127.0.0.1 */
+static int open_server(int type, uint16_t *port)
+{
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    int fd = ::socket(AF_INET, type, 0);
+
+    if(fd < 0) {
+        perror("LoopbackPeer: socket");
+        abort();
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    if((::bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) ||
+            ((type == SOCK_STREAM) && (::listen(fd, 16) != 0)) ||
+            (getsockname(fd, (struct sockaddr *)&addr, &addr_len) != 0)) {
+        perror("LoopbackPeer: bind");
+        abort();
+    }
+
+    set_nonblocking(fd);
+    *port = ntohs(addr.sin_port);
+    return fd;
+}
+
+LoopbackPeer::LoopbackPeer()
+: _stopping(false), _bytes_received(0), _bytes_sent(0), _connections(0)
+{
+    for(int mode = 0; mode < PEER_MODES; mode++) {
+        _tcp_fd[mode] = open_server(SOCK_STREAM, &_tcp_port[mode]);
+        _udp_fd[mode] = open_server(SOCK_DGRAM, &_udp_port[mode]);
+    }
+
+    if(::pipe(_wake_fd) != 0) {
+        perror("LoopbackPeer: pipe");
+        abort();
+    }
+    set_nonblocking(_wake_fd[0]);
+
+    _thread = std::thread(&LoopbackPeer::_thread_loop, this);
+}
+
+LoopbackPeer::~LoopbackPeer()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    char c = 0;
+    if(::write(_wake_fd[1], &c, 1) < 0) {
+        /* thread still notices `_stopping` with its next poll timeout */
+    }
+    _thread.join();
+
+    for(size_t i = 0; i < _conns.size(); i++) {
+        ::close(_conns[i].fd);
+    }
+    for(int mode = 0; mode < PEER_MODES; mode++) {
+        ::close(_tcp_fd[mode]);
+        ::close(_udp_fd[mode]);
+    }
+    ::close(_wake_fd[0]);
+    ::close(_wake_fd[1]);
+}
+
+uint64_t LoopbackPeer::bytes_received(void)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _bytes_received;
+}
+
+uint64_t LoopbackPeer::bytes_sent(void)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _bytes_sent;
+}
+
+uint32_t LoopbackPeer::connections(void)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _connections;
+}
+
+void LoopbackPeer::_thread_loop(void)
+{
+    while(true) {
+        std::vector<struct pollfd> pfds;
+        struct pollfd pfd;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if(_stopping) return;
+        }
+
+        pfd.revents = 0;
+        pfd.events = POLLIN;
+        pfd.fd = _wake_fd[0];
+        pfds.push_back(pfd);
+        for(int mode = 0; mode < PEER_MODES; mode++) {
+            pfd.fd = _tcp_fd[mode];
+            pfds.push_back(pfd);
+            pfd.fd = _udp_fd[mode];
+            pfds.push_back(pfd);
+        }
+        for(size_t i = 0; i < _conns.size(); i++) {
+            Connection &conn = _conns[i];
+            pfd.fd = conn.fd;
+            pfd.events = 0;
+            if(!conn.eof && (conn.out.size() < OUT_BUFFER)) pfd.events |= POLLIN;
+            if(!conn.out.empty()) pfd.events |= POLLOUT;
+            pfds.push_back(pfd);
+        }
+
+        if(::poll(&pfds[0], pfds.size(), 100) <= 0) continue;
+
+        if(pfds[0].revents & POLLIN) {
+            char c;
+            while(::read(_wake_fd[0], &c, 1) > 0) {}
+        }
+
+        for(int mode = 0; mode < PEER_MODES; mode++) {
+            if(pfds[1 + 2 * mode].revents & POLLIN) _accept((mode_t)mode);
+            if(pfds[2 + 2 * mode].revents & POLLIN) _udp_input((mode_t)mode);
+        }
+
+        /* connections accepted above are not part of `pfds` (yet) */
+        size_t polled = pfds.size() - (1 + 2 * PEER_MODES);
+        for(size_t i = 0, p = 1 + 2 * PEER_MODES; i < polled; p++) {
+            Connection &conn = _conns[i];
+            bool keep = true;
+
+            if(pfds[p].revents & (POLLIN | POLLHUP | POLLERR)) keep = _tcp_input(conn);
+            if(keep && (pfds[p].revents & POLLOUT)) keep = _tcp_output(conn);
+            if(keep && conn.eof && conn.out.empty() && (conn.source_left == 0)) keep = false;
+
+            if(keep) {
+                i++;
+            } else {
+                ::close(conn.fd);
+                _conns.erase(_conns.begin() + i);
+                polled--;
+            }
+        }
+    }
+}
+
+void LoopbackPeer::_accept(mode_t mode)
+{
+    int fd = ::accept(_tcp_fd[mode], NULL, NULL);
+    if(fd < 0) return;
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    set_nonblocking(fd);
+
+    Connection conn;
+    conn.fd = fd;
+    conn.mode = mode;
+    conn.eof = false;
+    conn.request_len = 0;
+    conn.source_left = 0;
+    conn.source_pos = 0;
+    _conns.push_back(conn);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _connections++;
+}
+
+void LoopbackPeer::_udp_input(mode_t mode)
+{
+    uint8_t buf[65536];
+    struct sockaddr_in from;
+    socklen_t from_len = sizeof(from);
+
+    ssize_t n = ::recvfrom(_udp_fd[mode], buf, sizeof(buf), 0, (struct sockaddr *)&from, &from_len);
+    if(n < 0) return;
+
+    uint64_t sent = 0;
+    switch(mode) {
+        case PEER_ECHO:
+            if(::sendto(_udp_fd[mode], buf, n, 0, (struct sockaddr *)&from, from_len) == n) sent = n;
+            break;
+        case PEER_SOURCE:
+            if(n == 8) {
+                uint32_t count, size;
+                memcpy(&count, buf, 4);
+                memcpy(&size, buf + 4, 4);
+                count = ntohl(count);
+                size = ntohl(size);
+                if(size > sizeof(buf)) size = sizeof(buf);
+
+                for(uint32_t i = 0; i < size; i++) buf[i] = pattern(i);
+                for(uint32_t i = 0; i < count; i++) {
+                    if(::sendto(_udp_fd[mode], buf, size, 0, (struct sockaddr *)&from, from_len) == (ssize_t)size) {
+                        sent += size;
+                    }
+                }
+            }
+            break;
+        default:
+            break;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _bytes_received += n;
+    _bytes_sent += sent;
+}
+
+/* returns false if the connection has to be dropped */
+bool LoopbackPeer::_tcp_input(Connection &conn)
+{
+    uint8_t buf[4096];
+    size_t room = OUT_BUFFER - conn.out.size();
+
+    if(conn.eof) return true;
+    if((conn.mode == PEER_ECHO) && (room < sizeof(buf))) {
+        if(room == 0) return true;
+    } else {
+        room = sizeof(buf);
+    }
+
+    ssize_t n = ::recv(conn.fd, buf, room, 0);
+    if(n < 0) return ((errno == EAGAIN) || (errno == EINTR));
+    if(n == 0) {
+        conn.eof = true;
+        return true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _bytes_received += n;
+    }
+
+    switch(conn.mode) {
+        case PEER_ECHO:
+            conn.out.insert(conn.out.end(), buf, buf + n);
+            break;
+        case PEER_SOURCE:
+            for(ssize_t i = 0; (i < n) && (conn.request_len < sizeof(conn.request)); i++) {
+                conn.request[conn.request_len++] = buf[i];
+                if(conn.request_len == sizeof(conn.request)) {
+                    uint32_t len;
+                    memcpy(&len, conn.request, sizeof(len));
+                    conn.source_left = ntohl(len);
+                    _fill_source(conn);
+                    if(conn.out.empty()) return false; // nothing requested
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    return true;
+}
+
+bool LoopbackPeer::_tcp_output(Connection &conn)
+{
+    uint8_t buf[4096];
+    size_t n = 0;
+
+    while((n < sizeof(buf)) && (n < conn.out.size())) {
+        buf[n] = conn.out[n];
+        n++;
+    }
+
+    ssize_t ret = ::send(conn.fd, buf, n, MSG_NOSIGNAL);
+    if(ret < 0) return ((errno == EAGAIN) || (errno == EINTR));
+
+    conn.out.erase(conn.out.begin(), conn.out.begin() + ret);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _bytes_sent += ret;
+    }
+
+    if(conn.mode == PEER_SOURCE) {
+        _fill_source(conn);
+        if((conn.source_left == 0) && conn.out.empty()) return false; // transfer complete
+    }
+    return true;
+}
+
+void LoopbackPeer::_fill_source(Connection &conn)
+{
+    while((conn.source_left > 0) && (conn.out.size() < OUT_BUFFER)) {
+        conn.out.push_back(pattern(conn.source_pos++));
+        conn.source_left--;
+    }
+}
+
+} // namespace spwf_sim
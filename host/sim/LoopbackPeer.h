@@ -0,0 +1,108 @@
+/* SPWFSAxx Devices - module simulator
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOOPBACK_PEER_H
+#define LOOPBACK_PEER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spwf_sim {
+
+/* Remote end of the simulated module's sockets: TCP & UDP servers on 127.0.0.1 (ephemeral ports)
+ *
+ * - `PEER_ECHO`:    sends back everything received (TCP: closes after the client has shut down its side)
+ * - `PEER_DISCARD`: counts & drops everything received
+ * - `PEER_SOURCE`:  TCP: on a request of a 32-bit length (network byte order) sends that many `pattern()` bytes
+ *                   and closes the connection.
+ *                   UDP: on a request of a 32-bit count & 32-bit size sends that many datagrams of `pattern()` bytes
+ */
+class LoopbackPeer {
+public:
+    typedef enum {
+        PEER_ECHO = 0,
+        PEER_DISCARD,
+        PEER_SOURCE,
+        PEER_MODES
+    } mode_t;
+
+    LoopbackPeer();
+    ~LoopbackPeer();
+
+    uint16_t tcp_port(mode_t mode) const {
+        return _tcp_port[mode];
+    }
+
+    uint16_t udp_port(mode_t mode) const {
+        return _udp_port[mode];
+    }
+
+    /* payload byte `i` of each `PEER_SOURCE` transfer */
+    static uint8_t pattern(size_t i) {
+        return (uint8_t)((i * 31 + 7) & 0xFF);
+    }
+
+    uint64_t bytes_received(void);
+    uint64_t bytes_sent(void);
+    uint32_t connections(void);
+
+private:
+    struct Connection {
+        int fd;
+        mode_t mode;
+        bool eof;                   // client has shut down its side
+        std::deque<uint8_t> out;
+        uint8_t request[4];
+        size_t request_len;
+        size_t source_left;
+        size_t source_pos;
+    };
+
+    enum {
+        OUT_BUFFER = 65536          // per connection, echo stops reading when full (backpressure)
+    };
+
+    void _thread_loop(void);
+    void _accept(mode_t mode);
+    void _udp_input(mode_t mode);
+    bool _tcp_input(Connection &conn);
+    bool _tcp_output(Connection &conn);
+    void _fill_source(Connection &conn);
+
+    int _tcp_fd[PEER_MODES];
+    int _udp_fd[PEER_MODES];
+    uint16_t _tcp_port[PEER_MODES];
+    uint16_t _udp_port[PEER_MODES];
+    int _wake_fd[2];
+    std::vector<Connection> _conns;
+
+    std::mutex _mutex;
+    bool _stopping;
+    uint64_t _bytes_received;
+    uint64_t _bytes_sent;
+    uint32_t _connections;
+
+    std::thread _thread;
+};
+
+} // namespace spwf_sim
+
+#endif // LOOPBACK_PEER_H
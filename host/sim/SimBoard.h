@@ -0,0 +1,56 @@
+/* SPWFSAxx Devices - module simulator
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SPWF_SIM_BOARD_H
+#define SPWF_SIM_BOARD_H
+
+#include "SpwfSAInterface.h"
+#include "mbed_host.h"
+#include "SpwfSim.h"
+
+namespace spwf_sim {
+
+/* Simulated module of the expansion board the driver has been built for, wired to the driver's
+ * (default) UART & reset pins. To be constructed before the driver's `SpwfSAInterface`. */
+class SimBoard {
+public:
+    static Config default_config(void) {
+#if MBED_CONF_IDW0XX1_EXPANSION_BOARD == IDW04A1
+        return Config(DIALECT_SPWFSA04);
+#else
+        return Config(DIALECT_SPWFSA01);
+#endif
+    }
+
+    explicit SimBoard(const Config &config = default_config()) : sim(config) {
+        mbed_host::attach_uart(MBED_CONF_IDW0XX1_TX, MBED_CONF_IDW0XX1_RX, sim.device());
+        if(SPWFSAXX_RESET_PIN != NC) {
+            mbed_host::attach_gpio(SPWFSAXX_RESET_PIN, mbed::callback(&sim, &SpwfSim::reset_line));
+        }
+    }
+
+    ~SimBoard() {
+        if(SPWFSAXX_RESET_PIN != NC) {
+            mbed_host::attach_gpio(SPWFSAXX_RESET_PIN, mbed::Callback<void(int)>());
+        }
+    }
+
+    SpwfSim sim;
+};
+
+} // namespace spwf_sim
+
+#endif // SPWF_SIM_BOARD_H
@@ -0,0 +1,1142 @@
+/* SPWFSAxx Devices - module simulator
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+
+#include "SpwfSim.h"
+
+namespace spwf_sim {
+
+static const struct {
+    int baud;
+    speed_t speed;
+} console_speeds[] = {
+    { 9600,     B9600 },
+    { 19200,    B19200 },
+    { 38400,    B38400 },
+    { 57600,    B57600 },
+    { 115200,   B115200 },
+    { 230400,   B230400 },
+    { 460800,   B460800 },
+    { 921600,   B921600 },
+};
+
+static const int socket_send_timeout_s = 10;
+
+static void fatal(const char *what)
+{
+    perror(what);
+    abort();
+}
+
+static speed_t baud_to_speed(int baud)
+{
+    for(size_t i = 0; i < sizeof(console_speeds) / sizeof(console_speeds[0]); i++) {
+        if(console_speeds[i].baud == baud) return console_speeds[i].speed;
+    }
+    return B0;
+}
+
+static int speed_to_baud(speed_t speed)
+{
+    for(size_t i = 0; i < sizeof(console_speeds) / sizeof(console_speeds[0]); i++) {
+        if(console_speeds[i].speed == speed) return console_speeds[i].baud;
+    }
+    return 0;
+}
+
+/* time needed to transfer `bytes` over a UART running 8N1 at `baud` */
+static std::chrono::microseconds uart_time(size_t bytes, int baud)
+{
+    return std::chrono::microseconds(((uint64_t)bytes * 10ULL * 1000000ULL) / (uint64_t)baud);
+}
+
+static std::vector<std::string> split(const std::string &str, char delim, size_t max_fields)
+{
+    std::vector<std::string> fields;
+    size_t start = 0;
+
+    while(true) {
+        size_t pos = str.find(delim, start);
+        if((pos == std::string::npos) || (fields.size() + 1 >= max_fields)) {
+            fields.push_back(str.substr(start));
+            return fields;
+        }
+        fields.push_back(str.substr(start, pos - start));
+        start = pos + 1;
+    }
+}
+
+static bool parse_uint(const std::string &str, unsigned long *value)
+{
+    char *end;
+
+    if(str.empty()) return false;
+    errno = 0;
+    *value = strtoul(str.c_str(), &end, 0);
+    return ((errno == 0) && (*end == '\0'));
+}
+
+Config::Config(dialect_t dialect)
+: dialect(dialect),
+  max_baud(921600), cmd_latency_us(0),
+  boot_ms(30), hw_started_ms(20), assoc_ms(30), scan_ms(20),
+  ap_ssid("spwf-sim"), ap_passphrase("spwf-sim-psk"), ap_priv_mode(2),
+  ip_addr("192.168.1.100"), gateway("192.168.1.1"), netmask("255.255.255.0"), rssi(-54),
+  socket_rx_buffer(8192),
+  trace(false)
+{
+    static const uint8_t default_mac[6] = { 0x00, 0x80, 0xE1, 0xB7, 0xC8, 0x9D };
+    memcpy(mac, default_mac, sizeof(mac));
+
+    AccessPoint ap;
+    ap.ssid = ap_ssid;
+    ap.channel = 6;
+    ap.rssi = rssi;
+    ap.security = "WPA2";
+    memcpy(ap.bssid, "\x00\x11\x22\x33\x44\x55", 6);
+    scan_results.push_back(ap);
+
+    ap.ssid = "guest's net";
+    ap.channel = 1;
+    ap.rssi = -71;
+    ap.security = "";
+    memcpy(ap.bssid, "\x02\x11\x22\x33\x44\x66", 6);
+    scan_results.push_back(ap);
+
+    ap.ssid = "legacy";
+    ap.channel = 11;
+    ap.rssi = -80;
+    ap.security = "WEP";
+    memcpy(ap.bssid, "\x02\x11\x22\x33\x44\x77", 6);
+    scan_results.push_back(ap);
+}
+
+SpwfSim::SpwfSim(const Config &config)
+: _cfg(config), _start(clock::now()), _master_fd(-1), _slave_fd(-1), _stopping(false),
+  _reset_level(1), _halted(true), _console_up(false), _active_speed(115200),
+  _radio_on(false), _associated(false), _epoch(0), _sta_epoch(0), _busy_fd(-1),
+  _data_left(0)
+{
+    struct termios tio;
+
+    if(getenv("SPWF_SIM_TRACE") != NULL) _cfg.trace = true;
+    memset(&_stats, 0, sizeof(_stats));
+
+    for(int id = 0; id < LINK_SOCKETS; id++) {
+        _sockets[id].open = false;
+        _sockets[id].fd = -1;
+    }
+
+    /* pseudo terminal, with the MCU on the slave side */
+    _master_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if((_master_fd < 0) || (grantpt(_master_fd) != 0) || (unlockpt(_master_fd) != 0)) {
+        fatal("SpwfSim: posix_openpt");
+    }
+    _device = ptsname(_master_fd);
+    _slave_fd = ::open(_device.c_str(), O_RDWR | O_NOCTTY);
+    if(_slave_fd < 0) fatal("SpwfSim: open slave");
+
+    /* raw line discipline from the beginning (no echo of what the module sends before the MCU opens the tty) */
+    if(tcgetattr(_slave_fd, &tio) != 0) fatal("SpwfSim: tcgetattr");
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, B115200);
+    cfsetospeed(&tio, B115200);
+    tcsetattr(_slave_fd, TCSANOW, &tio);
+    fcntl(_master_fd, F_SETFL, fcntl(_master_fd, F_GETFL) | O_NONBLOCK);
+
+    if(::pipe(_wake_fd) != 0) fatal("SpwfSim: pipe");
+    fcntl(_wake_fd[0], F_SETFL, fcntl(_wake_fd[0], F_GETFL) | O_NONBLOCK);
+    fcntl(_wake_fd[1], F_SETFL, fcntl(_wake_fd[1], F_GETFL) | O_NONBLOCK);
+
+    _factory_defaults(_flash);
+    _running = _flash;
+
+    _rx_thread = std::thread(&SpwfSim::_rx_thread_loop, this);
+    _tx_thread = std::thread(&SpwfSim::_tx_thread_loop, this);
+    _net_thread = std::thread(&SpwfSim::_net_thread_loop, this);
+
+    /* module gets powered up together with the board */
+    std::lock_guard<std::mutex> lock(_mutex);
+    _boot();
+}
+
+SpwfSim::~SpwfSim()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _tx_cv.notify_all();
+    _wake();
+
+    _rx_thread.join();
+    _tx_thread.join();
+    _net_thread.join();
+
+    for(int id = 0; id < LINK_SOCKETS; id++) {
+        if(_sockets[id].fd >= 0) ::close(_sockets[id].fd);
+    }
+    for(size_t i = 0; i < _dead_fds.size(); i++) {
+        ::close(_dead_fds[i]);
+    }
+    ::close(_wake_fd[0]);
+    ::close(_wake_fd[1]);
+    ::close(_slave_fd);
+    ::close(_master_fd);
+}
+
+void SpwfSim::reset_line(int level)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    level = (level != 0);
+    if(level == _reset_level) return;
+    _reset_level = level;
+
+    if(level == 0) {
+        _halt(true);
+    } else { // rising edge: boot with configuration saved in flash
+        _running = _flash;
+        _boot();
+    }
+}
+
+void SpwfSim::lose_network(unsigned recover_ms)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if(!_associated) return;
+
+    _associated = false;
+    _wind(33, "WiFi Network Lost");
+
+    uint32_t sta_epoch = ++_sta_epoch;
+    _schedule(recover_ms, [this, sta_epoch]() {
+        if((sta_epoch == _sta_epoch) && _radio_on) _associate();
+    });
+}
+
+void SpwfSim::set_cmd_latency(unsigned us)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cfg.cmd_latency_us = us;
+}
+
+void SpwfSim::set_scan_results(const std::vector<AccessPoint> &aps)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cfg.scan_results = aps;
+}
+
+int SpwfSim::console_speed(void)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _active_speed;
+}
+
+Stats SpwfSim::stats(void)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
+
+/* speed the MCU has currently configured its UART for */
+int SpwfSim::_mcu_speed(void)
+{
+    struct termios tio;
+
+    if(tcgetattr(_slave_fd, &tio) != 0) return 0;
+    return speed_to_baud(cfgetospeed(&tio));
+}
+
+void SpwfSim::_trace(const char *dir, const char *text)
+{
+    if(!_cfg.trace) return;
+
+    double t = std::chrono::duration<double>(clock::now() - _start).count();
+    fprintf(stderr, "SIM %9.3f %s %s\n", t, dir, text);
+}
+
+void SpwfSim::_wake(void)
+{
+    char c = 0;
+    if(::write(_wake_fd[1], &c, 1) < 0) {
+        /* pipe full, network thread gets woken up anyway */
+    }
+}
+
+/* MCU -> module: bytes get processed once they would have been completely received at the MCU's console speed */
+void SpwfSim::_rx_thread_loop(void)
+{
+    uint8_t buf[64];
+    clock::time_point rx_clock = clock::now();
+
+    while(true) {
+        struct pollfd pfd;
+        pfd.fd = _master_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+
+        int ret = ::poll(&pfd, 1, 20);
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if(_stopping) return;
+        }
+        if((ret <= 0) || !(pfd.revents & POLLIN)) continue;
+
+        ssize_t n = ::read(_master_fd, buf, sizeof(buf));
+        if(n <= 0) continue;
+
+        int speed = _mcu_speed(); // sampled at arrival, as the MCU might switch speed right after sending
+        if(speed > 0) {
+            clock::time_point now = clock::now();
+            if(rx_clock < now) rx_clock = now;
+            rx_clock += uart_time(n, speed);
+            std::this_thread::sleep_until(rx_clock);
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        for(ssize_t i = 0; i < n; i++) {
+            if(_halted || !_console_up || (speed != _active_speed) || (_active_speed > _cfg.max_baud)) {
+                _stats.uart_rx_garbled++;
+                continue;
+            }
+            _stats.uart_rx_bytes++;
+            _rx_byte(lock, buf[i]);
+        }
+    }
+}
+
+/* module -> MCU: output gets paced to the active console speed (& garbled in case of a speed mismatch) */
+void SpwfSim::_tx_thread_loop(void)
+{
+    uint8_t buf[64];
+    clock::time_point tx_clock = clock::now();
+
+    while(true) {
+        size_t n;
+        int speed;
+        bool garbled;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while(!_stopping && _tx_queue.empty()) _tx_cv.wait(lock);
+            if(_stopping) return;
+
+            n = (_tx_queue.size() < sizeof(buf)) ? _tx_queue.size() : sizeof(buf);
+            std::copy(_tx_queue.begin(), _tx_queue.begin() + n, buf);
+            _tx_queue.erase(_tx_queue.begin(), _tx_queue.begin() + n);
+            speed = _active_speed;
+            garbled = (speed > _cfg.max_baud);
+        }
+
+        if(_mcu_speed() != speed) garbled = true;
+        if(garbled) memset(buf, 0xFF, n);
+
+        clock::time_point now = clock::now();
+        if(tx_clock < now) tx_clock = now;
+        tx_clock += uart_time(n, speed);
+        std::this_thread::sleep_until(tx_clock);
+
+        size_t written = 0;
+        while(written < n) {
+            ssize_t ret = ::write(_master_fd, buf + written, n - written);
+            if(ret > 0) {
+                written += ret;
+            } else if((ret < 0) && (errno == EAGAIN)) {
+                struct pollfd pfd;
+                pfd.fd = _master_fd;
+                pfd.events = POLLOUT;
+                pfd.revents = 0;
+                if(::poll(&pfd, 1, 100) <= 0) break; // nobody reading (e.g. MCU not running), drop output
+            } else if(!((ret < 0) && (errno == EINTR))) {
+                break;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stats.uart_tx_bytes += written;
+    }
+}
+
+/* sockets & scheduled actions (boot sequence, association, scan results) */
+void SpwfSim::_net_thread_loop(void)
+{
+    std::vector<uint8_t> buf(65536);
+
+    while(true) {
+        std::vector<struct pollfd> pfds;
+        std::vector<int> ids;
+        int timeout = -1;
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if(_stopping) return;
+
+            for(std::vector<int>::iterator it = _dead_fds.begin(); it != _dead_fds.end();) {
+                if(*it == _busy_fd) {
+                    ++it;
+                } else {
+                    ::close(*it);
+                    it = _dead_fds.erase(it);
+                }
+            }
+
+            clock::time_point now = clock::now();
+            while(!_actions.empty() && (_actions.begin()->first <= now)) {
+                Action action = _actions.begin()->second;
+                _actions.erase(_actions.begin());
+                if(action.epoch == _epoch) action.func();
+            }
+            if(!_actions.empty()) {
+                timeout = (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+                              _actions.begin()->first - now).count() + 1;
+            }
+
+            struct pollfd pfd;
+            pfd.fd = _wake_fd[0];
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            pfds.push_back(pfd);
+
+            if(!_halted) {
+                for(int id = 0; id < LINK_SOCKETS; id++) {
+                    Socket &s = _sockets[id];
+                    if(!s.open || s.peer_closed || (s.rx.size() >= _cfg.socket_rx_buffer)) continue;
+
+                    pfd.fd = s.fd;
+                    pfds.push_back(pfd);
+                    ids.push_back(id);
+                }
+            }
+        }
+
+        ::poll(&pfds[0], pfds.size(), timeout);
+
+        if(pfds[0].revents & POLLIN) {
+            char c;
+            while(::read(_wake_fd[0], &c, 1) > 0) {}
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        for(size_t i = 1; i < pfds.size(); i++) {
+            if(!(pfds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+
+            int id = ids[i - 1];
+            Socket &s = _sockets[id];
+            if(_halted || !s.open || (s.fd != pfds[i].fd)) continue; // closed meanwhile
+
+            size_t room = _cfg.socket_rx_buffer - s.rx.size();
+            ssize_t n;
+
+            if(s.udp) {
+                n = ::recv(s.fd, &buf[0], buf.size(), MSG_DONTWAIT);
+                if(n < 0) continue;
+                if((size_t)n > room) { // module drops datagrams not fitting into its buffer
+                    _stats.udp_dropped++;
+                    continue;
+                }
+            } else {
+                n = ::recv(s.fd, &buf[0], (room < buf.size()) ? room : buf.size(), MSG_DONTWAIT);
+                if((n < 0) && ((errno == EAGAIN) || (errno == EINTR))) continue;
+                if(n <= 0) { // orderly shutdown resp. reset by peer
+                    s.peer_closed = true;
+                    if(_cfg.dialect == DIALECT_SPWFSA01) {
+                        _wind(58, "Socket Closed:%d", id);
+                    } else {
+                        _wind(58, "Socket Closed:%d:0", id);
+                    }
+                    continue;
+                }
+            }
+
+            s.rx.insert(s.rx.end(), buf.begin(), buf.begin() + n);
+            if(_cfg.dialect == DIALECT_SPWFSA01) {
+                _wind(55, "Pending Data:%d:%u", id, (unsigned)s.rx.size());
+            } else {
+                _wind(55, "Pending Data::%d:%u:%u", id, (unsigned)n, (unsigned)s.rx.size());
+            }
+        }
+    }
+}
+
+void SpwfSim::_rx_byte(std::unique_lock<std::mutex> &lock, uint8_t c)
+{
+    if(_data_left > 0) { // `AT+S.SOCKW` payload
+        _data.push_back(c);
+        if(--_data_left == 0) _cmd_sockw(lock);
+        return;
+    }
+
+    if(c == '\n') return;
+    if(c != '\r') {
+        if(_line.size() < MAX_LINE) _line += (char)c;
+        return;
+    }
+
+    std::string cmd;
+    cmd.swap(_line);
+    if(cmd.empty()) return;
+
+    if(_var_u32(_name("localecho1", "console_echo")) != 0) {
+        _out(cmd + "\r\n");
+    }
+    _execute(lock, cmd);
+}
+
+void SpwfSim::_execute(std::unique_lock<std::mutex> &lock, const std::string &cmd)
+{
+    size_t eq = cmd.find('=');
+    std::string name = cmd.substr(0, eq);
+    std::string args = (eq != std::string::npos) ? cmd.substr(eq + 1) : "";
+
+    _stats.commands++;
+    _trace("<", cmd.c_str());
+
+    if(_cfg.cmd_latency_us > 0) {
+        uint32_t epoch = _epoch;
+        lock.unlock();
+        usleep(_cfg.cmd_latency_us);
+        lock.lock();
+        if(_halted || (epoch != _epoch)) return;
+    }
+
+    if(cmd == "AT") {
+        _ok();
+    } else if(cmd == _name("AT&F", "AT+S.FCFG")) {
+        _factory_defaults(_running);
+        _ok();
+    } else if(cmd == _name("AT&W", "AT+S.WCFG")) {
+        _flash = _running;
+        _ok();
+    } else if(cmd == _name("AT+CFUN=1", "AT+S.RESET")) {
+        _sw_reset();
+    } else if(cmd == _name("AT&V", "AT+S.GCFG")) {
+        for(vars_t::const_iterator it = _running.begin(); it != _running.end(); ++it) {
+            _var(it->first, it->second);
+        }
+        _ok();
+    } else if(name == "AT+S.SCFG") {
+        _cmd_scfg(args);
+    } else if(name == "AT+S.GCFG") {
+        _cmd_gcfg(args);
+    } else if(name == "AT+S.STS") {
+        _cmd_sts(args);
+    } else if(cmd == "AT+S.PEERS=0,rx_rssi") {
+        if(!_associated) {
+            _error(41, "Not associated");
+            return;
+        }
+        _var("0.rx_rssi", std::to_string(_cfg.rssi));
+        _ok();
+    } else if(name == "AT+S.SSIDTXT") {
+        _running["wifi_ssid"] = args;
+        _ok();
+    } else if(name == "AT+S.WIFI") {
+        _cmd_wifi(args);
+    } else if(cmd == _name("AT+S.SCAN=a,s", "AT+S.SCAN=s,")) {
+        _cmd_scan();
+    } else if(name == "AT+S.SOCKON") {
+        _cmd_sockon(lock, args);
+    } else if(name == "AT+S.SOCKW") {
+        std::vector<std::string> fields = split(args, ',', 2);
+        unsigned long len;
+
+        if((fields.size() != 2) || !parse_uint(fields[1], &len)) {
+            _error(17, "Invalid arguments");
+            return;
+        }
+
+        /* payload follows right after the command */
+        _data_cmd = args;
+        _data.clear();
+        _data_left = len;
+        if(len == 0) _cmd_sockw(lock);
+    } else if(name == "AT+S.SOCKR") {
+        _cmd_sockr(args);
+    } else if(name == "AT+S.SOCKQ") {
+        _cmd_sockq(args);
+    } else if(name == "AT+S.SOCKC") {
+        _cmd_sockc(args);
+    } else {
+        _error(1, "Command not found");
+    }
+}
+
+void SpwfSim::_out(const std::string &str)
+{
+    _out(reinterpret_cast<const uint8_t *>(str.data()), str.size());
+}
+
+void SpwfSim::_out(const uint8_t *data, size_t len)
+{
+    _tx_queue.insert(_tx_queue.end(), data, data + len);
+    _tx_cv.notify_all();
+}
+
+void SpwfSim::_ok(void)
+{
+    _out(_name("\r\nOK\r\n", "AT-S.OK\r\n"));
+}
+
+void SpwfSim::_error(int code, const char *msg)
+{
+    char buf[128];
+
+    _trace(">", msg);
+
+    if(_cfg.dialect == DIALECT_SPWFSA01) {
+        snprintf(buf, sizeof(buf), "\r\nERROR: %s\r\n", msg);
+    } else {
+        snprintf(buf, sizeof(buf), "AT-S.ERROR:%d:%s\r\n", code, msg);
+    }
+    _out(buf);
+}
+
+void SpwfSim::_var(const std::string &name, const std::string &value)
+{
+    if(_cfg.dialect == DIALECT_SPWFSA01) {
+        _out("#  " + name + " = " + value + "\r\n");
+    } else {
+        _out("AT-S.Var:" + name + "=" + value + "\r\n");
+    }
+}
+
+/* raise asynchronous indication `code` (unless switched off) */
+void SpwfSim::_wind(int code, const char *fmt, ...)
+{
+    static const char *const wind_off_01[] = { "wind_off_low", "wind_off_medium", "wind_off_high" };
+    static const char *const wind_off_04[] = { "console_wind_off_low", "console_wind_off_medium", "console_wind_off_high" };
+    char buf[256];
+    va_list args;
+    int len;
+
+    if(_halted || !_console_up) return;
+
+    if((code / 32) < 3) {
+        const char *mask_name = (_cfg.dialect == DIALECT_SPWFSA01) ? wind_off_01[code / 32] : wind_off_04[code / 32];
+        if(_var_u32(mask_name) & (1UL << (code % 32))) {
+            _stats.winds_dropped++;
+            return;
+        }
+    }
+
+    len = snprintf(buf, sizeof(buf), "+WIND:%d:", code);
+    va_start(args, fmt);
+    len += vsnprintf(buf + len, sizeof(buf) - len, fmt, args);
+    va_end(args);
+    _trace(">", buf);
+
+    _out(std::string(buf) + "\r\n");
+    _stats.winds_sent++;
+}
+
+void SpwfSim::_cmd_scfg(const std::string &args)
+{
+    std::vector<std::string> fields = split(args, ',', 2);
+
+    if((fields.size() != 2) || (_running.find(fields[0]) == _running.end()) ||
+            (fields[0] == "nv_wifi_macaddr")) {
+        _error(17, "Invalid arguments");
+        return;
+    }
+
+    if(fields[0] == _name("console1_speed", "console_speed")) { // becomes active with next reset
+        unsigned long baud;
+        if(!parse_uint(fields[1], &baud) || (baud_to_speed((int)baud) == B0)) {
+            _error(17, "Invalid arguments");
+            return;
+        }
+    }
+
+    _running[fields[0]] = fields[1];
+    _ok();
+}
+
+void SpwfSim::_cmd_gcfg(const std::string &args)
+{
+    vars_t::const_iterator it = _running.find(args);
+
+    if(it == _running.end()) {
+        _error(17, "Invalid arguments");
+        return;
+    }
+
+    _var(it->first, it->second);
+    _ok();
+}
+
+void SpwfSim::_cmd_sts(const std::string &args)
+{
+    std::string value;
+
+    if(args == "ip_ipaddr") {
+        value = _cfg.ip_addr;
+    } else if(args == "ip_gw") {
+        value = _cfg.gateway;
+    } else if(args == "ip_netmask") {
+        value = _cfg.netmask;
+    } else {
+        _error(17, "Invalid arguments");
+        return;
+    }
+
+    _var(args, _associated ? value : "0.0.0.0");
+    _ok();
+}
+
+void SpwfSim::_cmd_wifi(const std::string &args)
+{
+    if((args != "0") && (args != "1")) {
+        _error(17, "Invalid arguments");
+        return;
+    }
+
+    _ok();
+
+    if(args == "0") {
+        _radio_on = false;
+        _associated = false;
+        _sta_epoch++;
+    } else if(!_radio_on) {
+        _radio_on = true;
+        _start_sta();
+    }
+}
+
+void SpwfSim::_cmd_scan(void)
+{
+    _schedule(_cfg.scan_ms, [this]() {
+        std::string out;
+        char buf[256];
+
+        if(_cfg.dialect == DIALECT_SPWFSA04) {
+            snprintf(buf, sizeof(buf), "AT-S.Parsing Networks:%u\r\n", (unsigned)_cfg.scan_results.size());
+            out += buf;
+        }
+
+        for(size_t i = 0; i < _cfg.scan_results.size(); i++) {
+            const AccessPoint &ap = _cfg.scan_results[i];
+
+            snprintf(buf, sizeof(buf),
+                     "%3u:\tBSS %02X:%02X:%02X:%02X:%02X:%02X CHAN: %02d RSSI: %d SSID: '%s' CAPS: %04X %s\r\n",
+                     (unsigned)(i + 1), ap.bssid[0], ap.bssid[1], ap.bssid[2], ap.bssid[3], ap.bssid[4], ap.bssid[5],
+                     ap.channel, ap.rssi, ap.ssid.c_str(), ap.security.empty() ? 0x0401 : 0x0431, ap.security.c_str());
+            out += buf;
+        }
+
+        _out(out + _name("\r\nOK\r\n", "AT-S.OK\r\n"));
+    });
+}
+
+void SpwfSim::_cmd_sockon(std::unique_lock<std::mutex> &lock, const std::string &args)
+{
+    std::vector<std::string> fields = split(args, ',', 4);
+    struct sockaddr_in addr;
+    unsigned long port;
+    bool udp;
+    int id;
+
+    if(fields.size() != 4) {
+        _error(17, "Invalid arguments");
+        return;
+    }
+    const std::string &type = (_cfg.dialect == DIALECT_SPWFSA01) ? fields[2] : fields[3];
+    if(((type != "t") && (type != "u")) || !parse_uint(fields[1], &port) || (port > 0xFFFF) ||
+            ((_cfg.dialect == DIALECT_SPWFSA01) && (fields[3] != "ind"))) {
+        _error(17, "Invalid arguments");
+        return;
+    }
+    udp = (type == "u");
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((uint16_t)port);
+    if(inet_pton(AF_INET, fields[0].c_str(), &addr.sin_addr) != 1) {
+        _error(17, "Invalid arguments");
+        return;
+    }
+
+    if(!_associated) {
+        _error(41, "Not associated");
+        return;
+    }
+
+    for(id = 0; id < LINK_SOCKETS; id++) {
+        if(!_sockets[id].open) break;
+    }
+    if(id == LINK_SOCKETS) {
+        _error(55, "Too many sockets");
+        return;
+    }
+
+    int fd = ::socket(AF_INET, udp ? SOCK_DGRAM : SOCK_STREAM, 0);
+    if(fd < 0) {
+        _error(55, "Failed to open socket");
+        return;
+    }
+    if(!udp) {
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    struct timeval tv = { socket_send_timeout_s, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    /* connect without blocking the rest of the module */
+    uint32_t epoch = _epoch;
+    _busy_fd = fd;
+    lock.unlock();
+    int ret = ::connect(fd, (struct sockaddr *)&addr, sizeof(addr));
+    lock.lock();
+    _busy_fd = -1;
+
+    if(_halted || (epoch != _epoch)) { // module has been reset meanwhile
+        _dead_fds.push_back(fd);
+        _wake();
+        return;
+    }
+    if((ret != 0) || _sockets[id].open) {
+        _dead_fds.push_back(fd);
+        _wake();
+        _error(55, "Failed to open socket");
+        return;
+    }
+
+    Socket &s = _sockets[id];
+    s.open = true;
+    s.udp = udp;
+    s.peer_closed = false;
+    s.fd = fd;
+    s.rx.clear();
+    _wake();
+
+    char buf[64];
+    if(_cfg.dialect == DIALECT_SPWFSA01) {
+        snprintf(buf, sizeof(buf), "\r\n ID: %02d\r\n", id);
+        _out(buf);
+        _ok();
+    } else {
+        snprintf(buf, sizeof(buf), "AT-S.On:%s:%d\r\n", fields[0].c_str(), id);
+        _out(buf);
+        _ok();
+    }
+}
+
+void SpwfSim::_cmd_sockw(std::unique_lock<std::mutex> &lock)
+{
+    std::vector<std::string> fields = split(_data_cmd, ',', 2);
+    int id;
+
+    _stats.sockw++;
+
+    if(!_valid_socket(fields[0], &id)) {
+        _error(17, "Invalid socket ID");
+        return;
+    }
+
+    Socket &s = _sockets[id];
+    if(s.peer_closed) {
+        _error(58, "Socket closed");
+        return;
+    }
+
+    std::vector<uint8_t> data;
+    data.swap(_data);
+
+    /* blocking send (e.g. TCP backpressure) stalls the console, like on the module */
+    uint32_t epoch = _epoch;
+    int fd = s.fd;
+    size_t sent = 0;
+    bool failed = false;
+
+    _busy_fd = fd;
+    lock.unlock();
+    if(s.udp) {
+        failed = (::send(fd, data.data(), data.size(), MSG_NOSIGNAL) != (ssize_t)data.size());
+    } else {
+        while(sent < data.size()) {
+            ssize_t ret = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if(ret < 0) {
+                if(errno == EINTR) continue;
+                failed = true;
+                break;
+            }
+            sent += ret;
+        }
+    }
+    lock.lock();
+    _busy_fd = -1;
+    _wake(); // let network thread close fd in case it got closed meanwhile
+
+    if(_halted || (epoch != _epoch)) return;
+
+    if(failed) {
+        _error(58, "Failed to send data");
+    } else {
+        _ok();
+    }
+}
+
+void SpwfSim::_cmd_sockr(const std::string &args)
+{
+    std::vector<std::string> fields = split(args, ',', 2);
+    unsigned long len;
+    int id;
+
+    _stats.sockr++;
+
+    if((fields.size() != 2) || !_valid_socket(fields[0], &id) || !parse_uint(fields[1], &len)) {
+        _error(17, "Invalid arguments");
+        return;
+    }
+
+    Socket &s = _sockets[id];
+    if(len > s.rx.size()) {
+        _error(17, "Not enough data");
+        return;
+    }
+
+    std::vector<uint8_t> data(s.rx.begin(), s.rx.begin() + len);
+    s.rx.erase(s.rx.begin(), s.rx.begin() + len);
+    _wake(); // buffer space freed
+
+    if(_cfg.dialect == DIALECT_SPWFSA04) {
+        char buf[64];
+        snprintf(buf, sizeof(buf), "AT-S.Reading:%lu:%u\r\n", len, (unsigned)s.rx.size());
+        _out(buf);
+    }
+    _out(data.data(), data.size());
+    _ok();
+}
+
+/* Note: fails for a TCP socket closed by the peer once all received data has been read */
+void SpwfSim::_cmd_sockq(const std::string &args)
+{
+    char buf[64];
+    int id;
+
+    _stats.sockq++;
+
+    if(!_valid_socket(args, &id)) {
+        _error(17, "Invalid socket ID");
+        return;
+    }
+
+    Socket &s = _sockets[id];
+    if(s.peer_closed && s.rx.empty()) {
+        _error(58, "Socket closed");
+        return;
+    }
+
+    if(_cfg.dialect == DIALECT_SPWFSA01) {
+        snprintf(buf, sizeof(buf), "\r\n DATALEN: %u\r\n", (unsigned)s.rx.size());
+    } else {
+        snprintf(buf, sizeof(buf), "AT-S.Query:%u\r\n", (unsigned)s.rx.size());
+    }
+    _out(buf);
+    _ok();
+}
+
+void SpwfSim::_cmd_sockc(const std::string &args)
+{
+    int id;
+
+    if(!_valid_socket(args, &id)) {
+        _error(17, "Invalid socket ID");
+        return;
+    }
+
+    _close_socket(id);
+    _ok();
+}
+
+void SpwfSim::_factory_defaults(vars_t &vars)
+{
+    char mac[32];
+
+    snprintf(mac, sizeof(mac), "%02X:%02X:%02X:%02X:%02X:%02X",
+             _cfg.mac[0], _cfg.mac[1], _cfg.mac[2], _cfg.mac[3], _cfg.mac[4], _cfg.mac[5]);
+
+    vars.clear();
+    vars[_name("console1_speed", "console_speed")] = "115200";
+    vars[_name("console1_hwfc", "console_hwfc")] = "0";
+    vars[_name("console1_enabled", "console_enabled")] = "1";
+    vars[_name("console1_delimiter", "console_delimiter")] = "13";
+    vars[_name("console1_errs", "console_errs")] = "0";
+    vars[_name("localecho1", "console_echo")] = "1";
+    vars[_name("wind_off_low", "console_wind_off_low")] = "0x00000000";
+    vars[_name("wind_off_medium", "console_wind_off_medium")] = "0x00000000";
+    vars[_name("wind_off_high", "console_wind_off_high")] = "0x00000000";
+    vars["blink_led"] = "1";
+    vars["sleep_enabled"] = "0";
+    vars["standby_enabled"] = "0";
+    vars["wifi_powersave"] = "1";
+    vars["wifi_mode"] = "1";
+    vars["wifi_priv_mode"] = "2";
+    vars["wifi_wpa_psk_text"] = "";
+    vars["wifi_ssid"] = "";
+    vars["wifi_opr_rate_mask"] = "0x003FFFCF";
+    vars["wifi_ht_mode"] = "0";
+    vars["nv_wifi_macaddr"] = mac;
+}
+
+/* stop the module (reset line low, resp. start of a SW reset) */
+void SpwfSim::_halt(bool flush_tx)
+{
+    _halted = true;
+    _console_up = false;
+    _radio_on = false;
+    _associated = false;
+    _epoch++;
+    _sta_epoch++;
+    _actions.clear();
+
+    for(int id = 0; id < LINK_SOCKETS; id++) {
+        if(_sockets[id].open) _close_socket(id);
+    }
+
+    _line.clear();
+    _data_left = 0;
+    _data.clear();
+    if(flush_tx) _tx_queue.clear();
+}
+
+/* `AT+CFUN=1` resp. `AT+S.RESET`: restart keeping the running configuration (incl. an updated console speed) */
+void SpwfSim::_sw_reset(void)
+{
+    _wind(2, "Reset");
+    _halt(false);
+    _boot();
+}
+
+void SpwfSim::_boot(void)
+{
+    _halted = false;
+
+    _schedule(_cfg.boot_ms, [this]() {
+        _active_speed = (int)_var_u32(_name("console1_speed", "console_speed"));
+        _console_up = true;
+        _stats.boots++;
+
+        if(_cfg.dialect == DIALECT_SPWFSA01) {
+            _wind(1, "Poweron (170612-c8e7ef3-SPWF01S)");
+            _wind(13, "ST SPWF01SA IWM: Copyright (c) 2012-2017 STMicroelectronics, Inc. All rights Reserved.");
+        } else {
+            _wind(1, "Poweron:170612-c8e7ef3-SPWF04S");
+            _wind(13, "Copyright (c) 2012-2017 STMicroelectronics, Inc. All rights Reserved:SPWF04Sx");
+        }
+        _wind(0, "Console active");
+
+        _schedule(_cfg.hw_started_ms, [this]() {
+            _wind(32, "WiFi Hardware Started");
+            _radio_on = true;
+            _start_sta();
+        });
+    });
+}
+
+/* start station mode (if configured), i.e. try to associate with the configured access point */
+void SpwfSim::_start_sta(void)
+{
+    uint32_t sta_epoch = ++_sta_epoch;
+    const std::string &ssid = _running["wifi_ssid"];
+    int priv_mode = (int)_var_u32("wifi_priv_mode");
+
+    if(!_radio_on || (_var_u32("wifi_mode") != 1) || ssid.empty()) return;
+
+    bool match = (ssid == _cfg.ap_ssid) && (priv_mode == _cfg.ap_priv_mode) &&
+                 ((priv_mode == 0) || (_running["wifi_wpa_psk_text"] == _cfg.ap_passphrase));
+
+    _assoc_attempt(sta_epoch, match);
+}
+
+void SpwfSim::_assoc_attempt(uint32_t sta_epoch, bool match)
+{
+    _schedule(_cfg.assoc_ms, [this, sta_epoch, match]() {
+        if(sta_epoch != _sta_epoch) return; // radio switched off resp. restarted meanwhile
+
+        if(match) {
+            _associate();
+        } else {
+            _wind(40, "WiFi Deauthentication:1");
+            _assoc_attempt(sta_epoch, match);
+        }
+    });
+}
+
+void SpwfSim::_associate(void)
+{
+    _associated = true;
+    _wind(25, "WiFi Association with '%s' successful", _cfg.ap_ssid.c_str());
+    if(_cfg.dialect == DIALECT_SPWFSA01) {
+        _wind(24, "WiFi Up:%s", _cfg.ip_addr.c_str());
+    } else {
+        _wind(24, "WiFi Up:1:%s", _cfg.ip_addr.c_str());
+    }
+}
+
+/* run `func` (with the module lock held) in `ms`, unless the module gets restarted meanwhile */
+void SpwfSim::_schedule(unsigned ms, std::function<void()> func)
+{
+    Action action;
+
+    action.epoch = _epoch;
+    action.func = func;
+    _actions.insert(std::make_pair(clock::now() + std::chrono::milliseconds(ms), action));
+    _wake();
+}
+
+void SpwfSim::_close_socket(int id)
+{
+    Socket &s = _sockets[id];
+
+    s.open = false;
+    if(s.fd >= 0) _dead_fds.push_back(s.fd);
+    s.fd = -1;
+    s.rx.clear();
+    _wake();
+}
+
+bool SpwfSim::_valid_socket(const std::string &arg, int *id)
+{
+    unsigned long value;
+
+    if(!parse_uint(arg, &value) || (value >= LINK_SOCKETS) || !_sockets[value].open) return false;
+
+    *id = (int)value;
+    return true;
+}
+
+uint32_t SpwfSim::_var_u32(const std::string &name)
+{
+    vars_t::const_iterator it = _running.find(name);
+    return (it != _running.end()) ? (uint32_t)strtoul(it->second.c_str(), NULL, 0) : 0;
+}
+
+} // namespace spwf_sim
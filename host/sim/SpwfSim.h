@@ -0,0 +1,241 @@
+/* SPWFSAxx Devices - module simulator
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SPWF_SIM_H
+#define SPWF_SIM_H
+
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace spwf_sim {
+
+typedef enum {
+    DIALECT_SPWFSA01 = 0,   // X-NUCLEO-IDW01M1 (`spwfsa01_at_strings.h`)
+    DIALECT_SPWFSA04        // X-NUCLEO-IDW04A1 (`spwfsa04_at_strings.h`)
+} dialect_t;
+
+/* Access point reported by `AT+S.SCAN` */
+struct AccessPoint {
+    std::string ssid;
+    uint8_t bssid[6];
+    int channel;
+    int rssi;
+    std::string security;   // as printed after the capabilities, i.e. "WEP", "WPA", "WPA2", "WPA WPA2" or "" (open)
+};
+
+struct Config {
+    explicit Config(dialect_t dialect = DIALECT_SPWFSA01);
+
+    dialect_t dialect;
+
+    /* console */
+    int max_baud;               // highest console speed the module's UART copes with (module is deaf & garbles above)
+    unsigned cmd_latency_us;    // processing time of each AT command
+
+    /* timing of module (re-)starts & association */
+    unsigned boot_ms;           // reset until "+WIND:0:Console active"
+    unsigned hw_started_ms;     // "+WIND:0" until "+WIND:32:WiFi Hardware Started"
+    unsigned assoc_ms;          // start of STA mode until "+WIND:24:WiFi Up" (resp. until each "+WIND:40")
+    unsigned scan_ms;           // duration of `AT+S.SCAN`
+
+    /* network the simulated access point provides */
+    std::string ap_ssid;
+    std::string ap_passphrase;
+    int ap_priv_mode;           // `wifi_priv_mode` (0: open, 1: WEP, 2: WPA)
+    std::string ip_addr;
+    std::string gateway;
+    std::string netmask;
+    int rssi;
+    uint8_t mac[6];
+    std::vector<AccessPoint> scan_results;
+
+    /* sockets */
+    size_t socket_rx_buffer;    // per socket receive buffer on the module (TCP applies backpressure, UDP drops)
+
+    bool trace;                 // log AT commands to `stderr` (also enabled by environment variable `SPWF_SIM_TRACE`)
+};
+
+struct Stats {
+    uint64_t uart_rx_bytes;     // received from the MCU (at matching console speed)
+    uint64_t uart_tx_bytes;     // sent to the MCU
+    uint64_t uart_rx_garbled;   // dropped because of console speed mismatch (resp. while halted)
+    uint32_t commands;
+    uint32_t sockw;
+    uint32_t sockr;
+    uint32_t sockq;
+    uint32_t winds_sent;
+    uint32_t winds_dropped;     // switched off (`wind_off_*`) while being raised
+    uint32_t udp_dropped;       // datagrams not fitting into a socket's receive buffer
+    uint32_t boots;
+};
+
+/* Simulated SPWF01SA resp. SPWF04SA Wi-Fi module
+ *
+ * Talks AT commands over a pseudo terminal (see `device()`) with the byte timing of the console speed,
+ * runs its sockets as real (loopback) TCP & UDP sockets of the host and follows the module's reset line.
+ * All timings are configurable, defaults are tuned for short test runs rather than real module timing.
+ */
+class SpwfSim {
+public:
+    explicit SpwfSim(const Config &config);
+    ~SpwfSim();
+
+    /* tty to open on the MCU side (slave side of the pseudo terminal) */
+    const char *device(void) const {
+        return _device.c_str();
+    }
+
+    /* level of the reset line (active low), a rising edge boots the module with its flash configuration */
+    void reset_line(int level);
+
+    /* let the module lose the access point ("+WIND:33") and re-associate after `recover_ms` */
+    void lose_network(unsigned recover_ms);
+
+    void set_cmd_latency(unsigned us);
+
+    /* access points reported by following scans */
+    void set_scan_results(const std::vector<AccessPoint> &aps);
+
+    /* currently active console speed */
+    int console_speed(void);
+
+    Stats stats(void);
+
+private:
+    typedef std::chrono::steady_clock clock;
+
+    struct Socket {
+        bool open;
+        bool udp;
+        bool peer_closed;
+        int fd;
+        std::deque<uint8_t> rx;
+    };
+
+    struct Action {
+        uint32_t epoch;
+        std::function<void()> func;
+    };
+
+    enum {
+        LINK_SOCKETS = 8,
+        MAX_LINE = 512
+    };
+
+    /* configuration variables (values as strings, named like in the module's dialect) */
+    typedef std::map<std::string, std::string> vars_t;
+
+    /* threads */
+    void _rx_thread_loop(void);
+    void _tx_thread_loop(void);
+    void _net_thread_loop(void);
+
+    /* console */
+    int _mcu_speed(void);
+    void _wake(void);
+    void _trace(const char *dir, const char *text);
+    void _rx_byte(std::unique_lock<std::mutex> &lock, uint8_t c);
+    void _execute(std::unique_lock<std::mutex> &lock, const std::string &cmd);
+    void _out(const std::string &str);
+    void _out(const uint8_t *data, size_t len);
+    void _ok(void);
+    void _error(int code, const char *msg);
+    void _var(const std::string &name, const std::string &value);
+    void _wind(int code, const char *fmt, ...);
+
+    /* commands */
+    void _cmd_scfg(const std::string &args);
+    void _cmd_gcfg(const std::string &args);
+    void _cmd_sts(const std::string &args);
+    void _cmd_wifi(const std::string &args);
+    void _cmd_scan(void);
+    void _cmd_sockon(std::unique_lock<std::mutex> &lock, const std::string &args);
+    void _cmd_sockw(std::unique_lock<std::mutex> &lock);
+    void _cmd_sockr(const std::string &args);
+    void _cmd_sockq(const std::string &args);
+    void _cmd_sockc(const std::string &args);
+
+    /* module life cycle */
+    void _factory_defaults(vars_t &vars);
+    void _halt(bool flush_tx);
+    void _sw_reset(void);
+    void _boot(void);
+    void _start_sta(void);
+    void _assoc_attempt(uint32_t sta_epoch, bool match);
+    void _associate(void);
+    void _schedule(unsigned ms, std::function<void()> func);
+    void _close_socket(int id);
+    bool _valid_socket(const std::string &arg, int *id);
+
+    uint32_t _var_u32(const std::string &name);
+    const char *_name(const char *name01, const char *name04) const {
+        return (_cfg.dialect == DIALECT_SPWFSA01) ? name01 : name04;
+    }
+
+    Config _cfg;
+    clock::time_point _start;
+    std::string _device;
+    int _master_fd;
+    int _slave_fd;      // kept open, so that the master never sees a hang up
+    int _wake_fd[2];    // wakes up network thread
+
+    std::mutex _mutex;
+    std::condition_variable _tx_cv;
+    bool _stopping;
+
+    /* module state */
+    vars_t _running;
+    vars_t _flash;
+    int _reset_level;
+    bool _halted;
+    bool _console_up;
+    int _active_speed;
+    bool _radio_on;
+    bool _associated;
+    uint32_t _epoch;    // incremented by each (re-)start, drops scheduled actions of the previous one
+    uint32_t _sta_epoch;    // incremented by each (re-)start of STA mode, drops pending association attempts
+    Socket _sockets[LINK_SOCKETS];
+    std::vector<int> _dead_fds;     // closed by the network thread
+    int _busy_fd;                   // in use by a blocking operation of the RX thread
+
+    /* console state */
+    std::string _line;
+    size_t _data_left;              // payload bytes of `AT+S.SOCKW` still to be received
+    std::string _data_cmd;
+    std::vector<uint8_t> _data;
+    std::deque<uint8_t> _tx_queue;
+
+    std::multimap<clock::time_point, Action> _actions;
+
+    Stats _stats;
+
+    std::thread _rx_thread;
+    std::thread _tx_thread;
+    std::thread _net_thread;
+};
+
+} // namespace spwf_sim
+
+#endif // SPWF_SIM_H
@@ -0,0 +1,210 @@
+/* SPWFSAxx Devices - host tests
+ * Copyright (c) 2015 ARM Limited
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Smoke test of the driver (as configured by the build) against the simulated module:
+ * association, getters, scan, TCP & UDP traffic, peer close & disconnect.
+ *
+ * With `SPWF_TEST_CONSOLE_FALLBACK` the module's UART gets limited below the console speed requested by
+ * `MBED_CONF_IDW0XX1_CONSOLE_SPEED`, i.e. the driver has to fall back to the default speed.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+
+#include "SimBoard.h"
+#include "LoopbackPeer.h"
+
+using namespace spwf_sim;
+
+static int failures = 0;
+
+#define CHECK(cond)                                                         \
+    do {                                                                    \
+        if(!(cond)) {                                                       \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                     \
+        }                                                                   \
+    } while(0)
+
+static void configure_socket(Socket &socket)
+{
+    socket.set_timeout(5000);
+
+#if SPWFSA_TX_COALESCING
+    int coalesce = 1;
+    socket.setsockopt(SPWFSA_SOCKOPT_LEVEL, SPWFSA_SOCKOPT_TX_COALESCE, &coalesce, sizeof(coalesce));
+#endif // SPWFSA_TX_COALESCING
+#if SPWFSA_ASYNC_SEND
+    int async = 1;
+    socket.setsockopt(SPWFSA_SOCKOPT_LEVEL, SPWFSA_SOCKOPT_TX_ASYNC, &async, sizeof(async));
+#endif // SPWFSA_ASYNC_SEND
+}
+
+static bool send_all(TCPSocket &socket, const uint8_t *data, size_t len)
+{
+    for(size_t sent = 0; sent < len;) {
+        size_t chunk = ((len - sent) < 100) ? (len - sent) : 100; // several small writes (exercise coalescing)
+        nsapi_size_or_error_t ret = socket.send(data + sent, chunk);
+        if(ret <= 0) return false;
+        sent += ret;
+    }
+    return true;
+}
+
+static void test_getters(SpwfSAInterface &wifi, const Config &config)
+{
+    const char *ip = wifi.get_ip_address();
+    const char *gw = wifi.get_gateway();
+    const char *mask = wifi.get_netmask();
+    const char *mac = wifi.get_mac_address();
+
+    CHECK(wifi.get_connection_status() == NSAPI_STATUS_GLOBAL_UP);
+    CHECK((ip != NULL) && (config.ip_addr == ip));
+    CHECK((gw != NULL) && (config.gateway == gw));
+    CHECK((mask != NULL) && (config.netmask == mask));
+    CHECK((mac != NULL) && (strcasecmp(mac, "00:80:e1:b7:c8:9d") == 0));
+    CHECK(wifi.get_rssi() == config.rssi);
+}
+
+static void test_scan(SpwfSAInterface &wifi, const Config &config)
+{
+    WiFiAccessPoint aps[8];
+    nsapi_size_or_error_t count = wifi.scan(aps, 8);
+
+    CHECK(count == (nsapi_size_or_error_t)config.scan_results.size());
+    for(int i = 0; (i < count) && (i < (int)config.scan_results.size()); i++) {
+        const AccessPoint &expected = config.scan_results[i];
+        CHECK(expected.ssid == aps[i].get_ssid());
+        CHECK(aps[i].get_channel() == expected.channel);
+        CHECK(aps[i].get_rssi() == expected.rssi);
+        CHECK(memcmp(aps[i].get_bssid(), expected.bssid, 6) == 0);
+    }
+    CHECK((count < 3) || (aps[0].get_security() == NSAPI_SECURITY_WPA2));
+    CHECK((count < 3) || (aps[1].get_security() == NSAPI_SECURITY_NONE));
+    CHECK((count < 3) || (aps[2].get_security() == NSAPI_SECURITY_WEP));
+}
+
+static void test_tcp_echo(SpwfSAInterface &wifi, LoopbackPeer &peer)
+{
+    static uint8_t tx[3000], rx[3000];
+    TCPSocket socket;
+
+    for(size_t i = 0; i < sizeof(tx); i++) tx[i] = LoopbackPeer::pattern(i * 7);
+
+    CHECK(socket.open(&wifi) == NSAPI_ERROR_OK);
+    configure_socket(socket);
+    CHECK(socket.connect("127.0.0.1", peer.tcp_port(LoopbackPeer::PEER_ECHO)) == NSAPI_ERROR_OK);
+    CHECK(send_all(socket, tx, sizeof(tx)));
+
+    size_t received = 0;
+    while(received < sizeof(rx)) {
+        nsapi_size_or_error_t ret = socket.recv(rx + received, sizeof(rx) - received);
+        if(ret <= 0) break;
+        received += ret;
+    }
+    CHECK(received == sizeof(rx));
+    CHECK(memcmp(tx, rx, received) == 0);
+    CHECK(socket.close() == NSAPI_ERROR_OK);
+}
+
+/* peer sends a block & closes: all data and then EOF have to be delivered */
+static void test_tcp_source(SpwfSAInterface &wifi, LoopbackPeer &peer)
+{
+    static uint8_t rx[6000];
+    const uint32_t len = 5000;
+    uint32_t request = htonl(len);
+    TCPSocket socket;
+
+    CHECK(socket.open(&wifi) == NSAPI_ERROR_OK);
+    configure_socket(socket);
+    CHECK(socket.connect("127.0.0.1", peer.tcp_port(LoopbackPeer::PEER_SOURCE)) == NSAPI_ERROR_OK);
+    CHECK(send_all(socket, (const uint8_t *)&request, sizeof(request)));
+
+    size_t received = 0;
+    nsapi_size_or_error_t ret;
+    while((ret = socket.recv(rx + received, sizeof(rx) - received)) > 0) {
+        received += ret;
+    }
+    CHECK(ret == 0);
+    CHECK(received == len);
+    for(size_t i = 0; i < received; i++) {
+        if(rx[i] != LoopbackPeer::pattern(i)) {
+            CHECK(rx[i] == LoopbackPeer::pattern(i));
+            break;
+        }
+    }
+    CHECK(socket.close() == NSAPI_ERROR_OK);
+}
+
+static void test_udp_echo(SpwfSAInterface &wifi, LoopbackPeer &peer)
+{
+    uint8_t tx[500], rx[600];
+    UDPSocket socket;
+    SocketAddress addr("127.0.0.1", peer.udp_port(LoopbackPeer::PEER_ECHO));
+
+    for(size_t i = 0; i < sizeof(tx); i++) tx[i] = LoopbackPeer::pattern(i + 3);
+
+    CHECK(socket.open(&wifi) == NSAPI_ERROR_OK);
+    socket.set_timeout(5000);
+    for(int n = 0; n < 3; n++) {
+        CHECK(socket.sendto(addr, tx, sizeof(tx)) == (nsapi_size_or_error_t)sizeof(tx));
+        nsapi_size_or_error_t ret = socket.recvfrom(NULL, rx, sizeof(rx));
+        CHECK(ret == (nsapi_size_or_error_t)sizeof(tx));
+        CHECK((ret > 0) && (memcmp(tx, rx, ret) == 0));
+    }
+    CHECK(socket.close() == NSAPI_ERROR_OK);
+}
+
+int main(void)
+{
+    Config config = SimBoard::default_config();
+#if defined(SPWF_TEST_CONSOLE_FALLBACK)
+    config.max_baud = SPWF_TEST_CONSOLE_FALLBACK;
+#endif // SPWF_TEST_CONSOLE_FALLBACK
+
+    LoopbackPeer peer;
+    SimBoard board(config);
+    SpwfSAInterface wifi;
+
+    /* wrong passphrase: association gets refused */
+    CHECK(wifi.connect(config.ap_ssid.c_str(), "wrong-psk", NSAPI_SECURITY_WPA2) != NSAPI_ERROR_OK);
+
+    CHECK(wifi.connect(config.ap_ssid.c_str(), config.ap_passphrase.c_str(), NSAPI_SECURITY_WPA2) == NSAPI_ERROR_OK);
+#if defined(SPWF_TEST_CONSOLE_FALLBACK)
+    CHECK(board.sim.console_speed() == 115200);
+#elif defined(MBED_CONF_IDW0XX1_CONSOLE_SPEED)
+    CHECK(board.sim.console_speed() == MBED_CONF_IDW0XX1_CONSOLE_SPEED);
+#endif
+
+    test_getters(wifi, config);
+    test_scan(wifi, config);
+    test_tcp_echo(wifi, peer);
+    test_tcp_source(wifi, peer);
+    test_udp_echo(wifi, peer);
+
+    CHECK(wifi.disconnect() == NSAPI_ERROR_OK);
+    CHECK(wifi.get_connection_status() == NSAPI_STATUS_DISCONNECTED);
+
+    Stats stats = board.sim.stats();
+    printf("smoke: %s (%u AT commands, %u WINDs, %u failed checks)\n", (failures == 0) ? "PASSED" : "FAILED",
+           stats.commands, stats.winds_sent, failures);
+    fflush(stdout);
+
+    /* skip static destruction, the driver's threads are still running */
+    _exit((failures == 0) ? 0 : 1);
+}